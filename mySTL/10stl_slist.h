@@ -14,6 +14,7 @@
 #include "1stl_alloctor.h"
 #include "1stl_construct.h"
 #include "1stl_iterator.h"
+#include "2stl_algobase.h"		//for less
 
 namespace lfp {
 namespace detail {
@@ -93,11 +94,41 @@ namespace detail {
 		return next_node;
 	}
 
-	//全局函数，计算单链表的元素个数
-	inline size_t __slist_size(__slist_node_base* node) {
-		size_t result = 0;
-		for (; node != 0; node = node->next) {
-			++result;
+	//全局函数，找出 node 的前一个节点，从 head 开始遍历
+	inline __slist_node_base* __slist_previous(
+		__slist_node_base* head,
+		const __slist_node_base* node)
+	{
+		while (head && head->next != node)
+			head = head->next;
+		return head;
+	}
+
+	//全局函数，将 (before_first, before_last] 内的节点接合于 pos 之后，只调整指针
+	inline void __slist_splice_after(
+		__slist_node_base* pos,
+		__slist_node_base* before_first,
+		__slist_node_base* before_last)
+	{
+		if (pos != before_first && pos != before_last) {
+			__slist_node_base* first = before_first->next;
+			__slist_node_base* after = pos->next;
+			before_first->next = before_last->next;
+			pos->next = first;
+			before_last->next = after;
+		}
+	}
+
+	//全局函数，将以 node 开始的单链表逆向，返回新的第一个节点
+	inline __slist_node_base* __slist_reverse(__slist_node_base* node) {
+		__slist_node_base* result = node;
+		node = node->next;
+		result->next = 0;
+		while (node) {
+			__slist_node_base* next = node->next;
+			node->next = result;
+			result = node;
+			node = next;
 		}
 		return result;
 	}
@@ -126,6 +157,7 @@ namespace detail {
 		typedef detail::__slist_iterator_base	slist_iterator_base;
 
 		slist_node_base dummyHead;	//头部。注意这是实体，而不是指针（dummyHead机制的作用请自己百度）
+		size_type node_count;		//元素个数，随插入、移除、接合一起维护，size() 为 O(1)
 
 		//以节点大小为单位的专属空间配置器
 		typedef simple_alloc<slist_node, Alloc> slist_node_allocater;
@@ -153,12 +185,18 @@ namespace detail {
 				node = (slist_node*)node->next;
 				destroy_node(tmp);
 			}
+			dummyHead.next = 0;
+			node_count = 0;
 		}
 		
 	public:
-		slist()  { dummyHead.next = 0; }
+		slist() : node_count(0) { dummyHead.next = 0; }
 		~slist() { clear(); }
 
+		//第一个元素之前的位置，用于在头部 insert_after、splice_after
+		iterator before_begin() { return iterator((slist_node*)&dummyHead); }
+		const_iterator before_begin() const { return iterator((slist_node*)&dummyHead); }
+
 		iterator begin() { return iterator((slist_node*)dummyHead.next); }
 		const_iterator begin() const { return iterator((slist_node*)dummyHead.next); }
 
@@ -168,19 +206,23 @@ namespace detail {
 		reference front() { return ((slist_node*)dummyHead.next)->data; }
 		const_reference front() const { return ((slist_node*)dummyHead.next)->data; }
 
-		size_type size() const { return detail::__slist_size(dummyHead.next); }
+		size_type size() const { return node_count; }
+		bool empty() const { return dummyHead.next == 0; }
 
 		void push_front(const value_type& x) {
 			detail::__slist_make_link(&dummyHead, create_node(x));
+			++node_count;
 		}
 		void pop_front() {
 			slist_node* node = (slist_node*)dummyHead.next;
 			dummyHead.next = node->next;
 			destroy_node(node);
+			--node_count;
 		}
 
 		iterator insert_after(iterator pos, const value_type& x) {
 			detail::__slist_make_link(pos.node, create_node(x));
+			++node_count;
 			return iterator((slist_node*)pos.node->next);
 		}
 
@@ -188,6 +230,7 @@ namespace detail {
 			slist_node* node = (slist_node*)pos.node->next;
 			pos.node->next = node->next;
 			destroy_node(node);
+			--node_count;
 
 			return iterator((slist_node*)pos.node->next);
 		}
@@ -197,10 +240,124 @@ namespace detail {
 			slist_node_base* tmp = dummyHead.next;
 			dummyHead.next = rhs.dummyHead.next;
 			rhs.dummyHead.next = tmp;
+			size_type n = node_count;
+			node_count = rhs.node_count;
+			rhs.node_count = n;
+		}
+
+		/* 以下接合操作只调整节点指针，不配置也不复制元素 */
+		//将 x 的全部元素接合于 pos 之后，x 必须不同于 *this。需要找到 x 的尾节点，O(x.size())
+		void splice_after(iterator pos, slist& x) {
+			if (x.empty() || &x == this)
+				return;
+			slist_node_base* before_last = detail::__slist_previous(&x.dummyHead, 0);
+			detail::__slist_splice_after(pos.node, &x.dummyHead, before_last);
+			node_count += x.node_count;
+			x.node_count = 0;
+		}
+		//将 x 中 prev 之后的那一个元素接合于 pos 之后，x 可以就是 *this，O(1)
+		void splice_after(iterator pos, slist& x, iterator prev) {
+			if (pos == prev || pos.node == prev.node->next)
+				return;
+			detail::__slist_splice_after(pos.node, prev.node, prev.node->next);
+			++node_count;
+			--x.node_count;
+		}
+		//将 x 中 (before_first, before_last] 内的元素接合于 pos 之后，pos 不能位于该区间之内
+		//x 就是 *this 时为 O(1)，否则需要统计接合的元素个数
+		void splice_after(iterator pos, slist& x, iterator before_first, iterator before_last) {
+			if (before_first == before_last)
+				return;
+			if (&x != this) {
+				size_type n = 0;
+				for (slist_node_base* cur = before_first.node; cur != before_last.node; cur = cur->next)
+					++n;
+				node_count += n;
+				x.node_count -= n;
+			}
+			detail::__slist_splice_after(pos.node, before_first.node, before_last.node);
+		}
+
+		//将 this 的内容逆向重置
+		void reverse() {
+			if (dummyHead.next)
+				dummyHead.next = detail::__slist_reverse(dummyHead.next);
 		}
+
+		//merge 将 x 合并到 this 身上，前提是两个 slist 已经按 comp 排序好了，合并后 x 为空
+		void merge(slist& x) { merge(x, less<T>()); }
+		template<class Compare>
+		void merge(slist& x, Compare comp);
+
+		//自底向上的归并排序，只调整节点指针，不复制元素；排序是稳定的，时间复杂度 O(nlogn)
+		void sort() { sort(less<T>()); }
+		template<class Compare>
+		void sort(Compare comp);
 	};
 
 
+	//merge 将 x 合并到 this 身上，相等时 this 中的元素在前，保证稳定
+	template<class T, class Alloc>
+	template<class Compare>
+	void slist<T, Alloc>::merge(slist& x, Compare comp) {
+		if (&x == this)
+			return;
+
+		slist_node_base* cur = &dummyHead;
+		while (cur->next && x.dummyHead.next) {
+			if (comp(((slist_node*)x.dummyHead.next)->data, ((slist_node*)cur->next)->data))
+				detail::__slist_splice_after(cur, &x.dummyHead, x.dummyHead.next);
+			cur = cur->next;
+		}
+		if (x.dummyHead.next) {		//x 中剩下的元素都不小于 this 中的元素，直接接在尾部
+			cur->next = x.dummyHead.next;
+			x.dummyHead.next = 0;
+		}
+		node_count += x.node_count;
+		x.node_count = 0;
+	}
+
+	//counter[i] 为空或保存一段长度为 2^i 的有序链表，每次从 this 中摘下一个节点，
+	//像二进制加法进位一样依次与 counter[0]、counter[1]... 合并，最后把所有 counter 合并起来
+	template<class T, class Alloc>
+	template<class Compare>
+	void slist<T, Alloc>::sort(Compare comp) {
+		//首先判断链表为空或只有一个元素则不进行任何操作
+		if (dummyHead.next == 0 || dummyHead.next->next == 0)
+			return;
+
+		slist carry;
+		slist counter[64];		//slist 的 dummyHead 是实体，构造这些空链表不需要配置内存
+		int fill = 0;
+		try {
+			while (!empty()) {
+				detail::__slist_splice_after(&carry.dummyHead, &dummyHead, dummyHead.next);	//摘下第一个节点
+				carry.node_count = 1;
+				--node_count;
+
+				int i = 0;
+				while (i < fill && !counter[i].empty()) {		//进位
+					counter[i].merge(carry, comp);		//counter[i] 中的元素较早，相等时在前，保证稳定
+					carry.swap(counter[i++]);
+				}
+				carry.swap(counter[i]);
+				if (i == fill)
+					++fill;
+			}
+
+			for (int i = 1; i < fill; ++i)
+				counter[i].merge(counter[i - 1], comp);
+			swap(counter[fill - 1]);
+		}
+		catch (...) {		//comp 抛出异常时把所有节点接回 this，不丢失任何元素
+			splice_after(before_begin(), carry);
+			for (int i = 0; i < fill; ++i)
+				splice_after(before_begin(), counter[i]);
+			throw;
+		}
+	}
+
+
 } // end of namespace lfp
 
-#endif	//! _STL_SLIST_H_
\ No newline at end of file
+#endif	//! _STL_SLIST_H_
\ No newline at end of file
@@ -11,6 +11,13 @@
  *红黑树的详细讲解请查看：https://zh.wikipedia.org/wiki/%E7%BA%A2%E9%BB%91%E6%A0%91
  *
  *红黑树删除节点算法请看：https://blog.csdn.net/qq_40843865/article/details/102498310
+ *
+ *节点的附加信息（augmentation）：
+ *	rb_tree 的最后一个模板参数 Augment 提供 static void update(__rb_tree_node_base* x)，根据x的两个子节点重新计算x的附加信息，
+ *	以及 enabled 表示是否需要维护。旋转时对两个旋转点调用 update，插入、删除时对受影响节点到根节点的路径自下而上调用 update
+ *	缺省的 __rb_tree_default_augment 在定义了 __STL_RB_TREE_ORDER_STATISTICS 时维护每个节点的子树大小，
+ *	由此 rb_tree 及 set、multiset、map、multimap 提供对数时间的 nth(k)、rank(key)、distance(first, last)；
+ *	未定义时什么也不做，节点中也没有这个字段。自定义的 Augment 应先调用 __rb_tree_default_augment::update
  */
 
 #ifndef _STL_RB_TREE_H_
@@ -18,9 +25,13 @@
 
 #include "1stl_alloctor.h"
 #include "1stl_construct.h"
-#include "8stl_queue.h"		//queue 用于清空红黑树
-#include <utility>			//pair
-#include <string.h>
+#include "1stl_iterator.h"		//for distance
+#include "2stl_algobase.h"		//for swap
+#include <iterator>			//for std::forward_iterator_tag
+#include <new>				//for placement new
+#include <type_traits>		//for is_convertible conditional
+#include <utility>			//pair forward
+#include <stdint.h>			//for uintptr_t
 
 
 namespace lfp {
@@ -33,14 +44,39 @@ namespace detail {
 
 /* rb_tree 节点采用双层架构 */
 /* rb_tree 基础节点结构，基础节点存储颜色、父节点和左右子节点 */
+/* 定义 __STL_RB_TREE_COMPACT_NODE 时颜色存放在父节点指针的最低位（节点至少按指针大小对齐，该位总是0），
+   基础节点由 32 字节缩小为 24 字节（64 位平台），如 set<int> 的节点由 40 字节缩小为 32 字节。
+   颜色与父节点一律通过 color()、parent() 读取，set_color()、set_parent() 写入 */
 	struct __rb_tree_node_base {
 		typedef __rb_tree_color_type color_type;
 		typedef __rb_tree_node_base* base_ptr;
 
-		color_type color;	//节点颜色
-		base_ptr parent;	//父节点指针
+#ifdef __STL_RB_TREE_COMPACT_NODE
+		uintptr_t parent_and_color;		//父节点指针 | 颜色
+#else
+		color_type color_field;		//节点颜色
+		base_ptr parent_field;		//父节点指针
+#endif
 		base_ptr left;		//左子节点
 		base_ptr right;		//右子节点
+#ifdef __STL_RB_TREE_ORDER_STATISTICS
+		size_t size;		//以本节点为根的子树中的节点个数
+#endif
+
+#ifdef __STL_RB_TREE_COMPACT_NODE
+		base_ptr parent() const { return (base_ptr)(parent_and_color & ~uintptr_t(1)); }
+		color_type color() const { return color_type(parent_and_color & 1); }
+		void set_parent(base_ptr p) { parent_and_color = uintptr_t(p) | (parent_and_color & 1); }
+		void set_color(color_type c) { parent_and_color = (parent_and_color & ~uintptr_t(1)) | uintptr_t(c); }
+		//新配置的节点两者都未初始化，必须先同时设定，之后才能单独修改其中之一
+		void set_parent_and_color(base_ptr p, color_type c) { parent_and_color = uintptr_t(p) | uintptr_t(c); }
+#else
+		base_ptr parent() const { return parent_field; }
+		color_type color() const { return color_field; }
+		void set_parent(base_ptr p) { parent_field = p; }
+		void set_color(color_type c) { color_field = c; }
+		void set_parent_and_color(base_ptr p, color_type c) { parent_field = p; color_field = c; }
+#endif
 
 		static base_ptr get_min_node(base_ptr x) {
 			while (x->left != nullptr)
@@ -55,12 +91,45 @@ namespace detail {
 		
 		//获得其兄弟节点，只能在已知当前节点有brother节点的情况下调用，否则结果未可预期
 		base_ptr get_brother() {
-			if (this->parent->left == this)
-				return this->parent->right;
-			return this->parent->left;
+			if (this->parent()->left == this)
+				return this->parent()->right;
+			return this->parent()->left;
 		}
 	};
 
+#ifdef __STL_RB_TREE_COMPACT_NODE
+	static_assert(alignof(__rb_tree_node_base) >= 2, "颜色存放在父节点指针的最低位，节点至少要按2字节对齐");
+#endif
+
+/* 缺省的附加信息：定义了 __STL_RB_TREE_ORDER_STATISTICS 时维护子树大小 */
+	struct __rb_tree_default_augment {
+#ifdef __STL_RB_TREE_ORDER_STATISTICS
+		enum { enabled = 1 };
+		static size_t size(const __rb_tree_node_base* x) { return x ? x->size : 0; }
+		static void update(__rb_tree_node_base* x) { x->size = 1 + size(x->left) + size(x->right); }
+#else
+		enum { enabled = 0 };
+		static void update(__rb_tree_node_base*) { }
+#endif
+	};
+
+/* 自x起沿父节点往上直至header（不含），依次更新附加信息 */
+	template<class Augment>
+	inline void __rb_tree_augment_path(__rb_tree_node_base* x, __rb_tree_node_base* header) {
+		if (!Augment::enabled)
+			return;
+		for (; x != header; x = x->parent())
+			Augment::update(x);
+	}
+
+/* 迭代器种类 Category 是否可以多次遍历（本库或标准库的 forward_iterator_tag 及其派生） */
+	template<class Category>
+	struct __rb_tree_multipass {
+		enum { value = std::is_convertible<Category, forward_iterator_tag>::value
+					|| std::is_convertible<Category, std::forward_iterator_tag>::value };
+		typedef typename std::conditional<value, __true_type, __false_type>::type type;
+	};
+
 /* rb_tree 正规节点结构，正规节点存储元素值 */
 	template<class Value>
 	struct __rb_tree_node : public __rb_tree_node_base {
@@ -94,10 +163,10 @@ namespace detail {
 				}
 			}
 			else {			//node 没有右子节点
-				base_ptr parent = node->parent;		//找到父节点
+				base_ptr parent = node->parent();		//找到父节点
 				while (parent->right == node) {		//如果现行节点本身是右子节点
 					node = parent;					//就一直上溯，直至不为右子节点为止
-					parent = node->parent;
+					parent = node->parent();
 				}
 
 				if (node->right != parent) {		//若此时的右子节点不等于父节点
@@ -112,8 +181,8 @@ namespace detail {
 		void decrment() {
 			if (node->left == node)
 				return;
-			if (node->color == __rb_tree_red &&		//如果node是红节点，且父节点的父节点等于自己，表示此时node指向
-				node->parent->parent == node)		//header（即end()）。相当于执行 --end()，right-most 即为解答
+			if (node->color() == __rb_tree_red &&		//如果node是红节点，且父节点的父节点等于自己，表示此时node指向
+				node->parent()->parent() == node)		//header（即end()）。相当于执行 --end()，right-most 即为解答
 			{
 				node = node->right;		//注意：header之右子节点即right-most，执行整棵树的max节点
 			}
@@ -123,11 +192,11 @@ namespace detail {
 					node = node->right;					
 			}
 			else {	//node既header节点也无左子节点
-				base_ptr parent = node->parent;	//找到 node 的父节点
+				base_ptr parent = node->parent();	//找到 node 的父节点
 
 				while (node == parent->left) {			//当现行节点身为左子节点
 					node = parent;						//一直往上走，直至不为左子节点
-					parent = node->parent;
+					parent = node->parent();
 				}
 				node = parent;			//此时的父节点即为解答
 			}
@@ -184,9 +253,12 @@ namespace detail {
 
 
 /* 相关函数声明 */
-	void __rb_tree_rotate_left(__rb_tree_node_base*, __rb_tree_node_base*&);
-	void __rb_tree_rotate_right(__rb_tree_node_base*, __rb_tree_node_base*&);
-	void __rb_tree_rebalance(__rb_tree_node_base*, __rb_tree_node_base*&);
+	template<class Augment>
+	void __rb_tree_rotate_left(__rb_tree_node_base*, __rb_tree_node_base*);
+	template<class Augment>
+	void __rb_tree_rotate_right(__rb_tree_node_base*, __rb_tree_node_base*);
+	template<class Augment>
+	void __rb_tree_rebalance(__rb_tree_node_base*, __rb_tree_node_base*);
 
 
 
@@ -196,13 +268,14 @@ namespace detail {
 	/* Value:		rb_tree实际存储的元素型别，通过对应键值的出排列顺序 */
 	/* KeyOfValue:	键值提取方法，得出某个元素实值所对应的键值 */
 	/* Compare:		键值比较规则 */
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc = alloc>
+	/* Augment:		节点附加信息的维护方法，见文件开头的说明 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc = alloc, class Augment = __rb_tree_default_augment>
 	struct rb_tree {
 	protected:
 		typedef __rb_tree_color_type	color_type;
 		typedef __rb_tree_node_base*	base_ptr;
 		typedef __rb_tree_node<Value>	rb_tree_node;
-		typedef rb_tree<Key, Value, KeyOfValue, Compare, Alloc> self;
+		typedef rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment> self;
 
 		/* 定义专属空间配置器，每次配置一个节点的空间 */
 		typedef simple_alloc<rb_tree_node, Alloc> rb_tree_node_allocator;
@@ -226,26 +299,29 @@ namespace detail {
 		Compare key_compare;		//节点键值大小比较准则
 
 
-		/* 以下三个函数用来方便取得 header 的成员 */
-		node_pointer& root() const { return (node_pointer&) header->parent; }
-		node_pointer& leftmost() const { return (node_pointer&) header->left; }
-		node_pointer& rightmost() const { return (node_pointer&) header->right; }
+		/* 以下三个函数用来方便取得 header 的成员，root 即 header 的父节点，以 set_root 修改 */
+		/* 注意：可写的引用必须是 base_ptr&。若将 base_ptr 成员强制转型为 node_pointer& 再写入，
+		   违反严格别名规则，-O2 下编译器可能沿用旧值（曾导致删除节点后死循环） */
+		base_ptr root() const { return header->parent(); }
+		void set_root(base_ptr x) const { header->set_parent(x); }
+		base_ptr& leftmost() const { return header->left; }
+		base_ptr& rightmost() const { return header->right; }
 
-		/* 以下六个函数方便用来取得node_pointer节点的成员 */
-		static node_pointer& left(node_pointer x) { return (node_pointer&) (x->left); }
-		static node_pointer& right(node_pointer x) { return (node_pointer&) (x->right); }
-		static node_pointer& parent(node_pointer x) { return (node_pointer&) (x->parent); }
+		/* 以下六个函数方便用来取得node_pointer节点的成员，指针成员只读，修改请直接写 x->left 等 */
+		static node_pointer left(node_pointer x) { return (node_pointer) (x->left); }
+		static node_pointer right(node_pointer x) { return (node_pointer) (x->right); }
+		static node_pointer parent(node_pointer x) { return (node_pointer) (x->parent()); }
 		static reference value(node_pointer x) { return x->value_field; }
 		static const Key& key(node_pointer x) { return KeyOfValue()(x->value_field); }	  //提取元素对应的键值
-		static color_type& color(node_pointer x) { return (color_type&) (x->color); }
+		static color_type color(node_pointer x) { return x->color(); }
 
 		/* 以下六个函数用来方便取得base_ptr节点的成员 */
-		static node_pointer& left(base_ptr x) { return (node_pointer&) (x->left); }
-		static node_pointer& right(base_ptr x) { return (node_pointer&) (x->right); }
-		static node_pointer& parent(base_ptr x) { return (node_pointer&) (x->parent); }
+		static node_pointer left(base_ptr x) { return (node_pointer) (x->left); }
+		static node_pointer right(base_ptr x) { return (node_pointer) (x->right); }
+		static node_pointer parent(base_ptr x) { return (node_pointer) (x->parent()); }
 		static reference value(base_ptr x) { return ((node_pointer)x)->value_field; }
 		static const Key& key(base_ptr x) { return KeyOfValue()(value(x)); }
-		static color_type& color(base_ptr x) { return (color_type&)(node_pointer(x)->color); }
+		static color_type color(base_ptr x) { return x->color(); }
 
 		//求取树 x 的最大值和最小值
 		static node_pointer get_min_node(node_pointer x) {
@@ -267,13 +343,27 @@ namespace detail {
 			}
 			catch (...) {
 				put_node(node);
+				throw;
+			}
+			return node;
+		}
+		/* 以 args 就地构造元素，生成一个节点 */
+		template<class... Args>
+		node_pointer create_node(Args&&... args) {
+			node_pointer node = get_node();
+			try {
+				new (&(node->value_field)) value_type(std::forward<Args>(args)...);
+			}
+			catch (...) {
+				put_node(node);
+				throw;
 			}
 			return node;
 		}
 		/* 复制一个节点（颜色和值） */
 		node_pointer clone_node(const node_pointer x) {
 			node_pointer node = create_node(x->value_field);
-			node->color = x->color;
+			node->set_parent_and_color(nullptr, x->color());
 			node->left = nullptr;
 			node->right = nullptr;
 			return node;
@@ -283,25 +373,103 @@ namespace detail {
 			destroy(&x->value_field);
 			put_node(x);
 		}
+		/* 元素有 trivial destructor 时不必析构，只需归还空间 */
+		void release_node(node_pointer x, __true_type) { put_node(x); }
+		void release_node(node_pointer x, __false_type) { destroy_node(x); }
 
 	private:
-		/* 内部插入函数: x为新值插入点，y为插入点的父节点，v为待插入值。返回指向新插入节点的迭代器 */
-		iterator __insert(base_ptr x, base_ptr y, const value_type& v);
+#ifdef __STL_RB_TREE_ORDER_STATISTICS
+		static size_type subtree_size(base_ptr x) { return __rb_tree_default_augment::size(x); }
+#endif
+
+		/* 内部插入函数: x为新值插入点，y为插入点的父节点，z为已生成的新节点。返回指向新插入节点的迭代器 */
+		iterator __insert(base_ptr x, base_ptr y, node_pointer z);
+
+		/* 寻找键值 k 的插入点，传回 (x, y)，含义同 __insert 的前两个参数；
+		   __insert_unique_pos 发现键值重复时传回 (重复的节点, 空) */
+		std::pair<base_ptr, base_ptr> __insert_unique_pos(const Key& k);
+		std::pair<base_ptr, base_ptr> __insert_equal_pos(const Key& k);
+
+		/* 以 position 为提示寻找键值 k 的插入点：k 恰好落在 position 与其前驱或后继之间时只需常数次比较，
+		   否则退回从根节点往下寻找 */
+		std::pair<base_ptr, base_ptr> __insert_hint_unique_pos(const_iterator position, const Key& k);
+		std::pair<base_ptr, base_ptr> __insert_hint_equal_pos(const_iterator position, const Key& k);
+
+		/* 将已生成的节点 z 插入 pos 处，键值重复时销毁 z */
+		std::pair<iterator, bool> __insert_node_unique(std::pair<base_ptr, base_ptr> pos, node_pointer z) {
+			if (pos.second == nullptr) {
+				destroy_node(z);
+				return std::pair<iterator, bool>(iterator((node_pointer)pos.first), false);
+			}
+			return std::pair<iterator, bool>(__insert(pos.first, pos.second, z), true);
+		}
 		
 		/* 复制整棵树 x */
 		node_pointer __copy(node_pointer x);
 
+		/* 销毁以 x 为根的整棵子树，不调整平衡；不配置堆内存，只用一个大小固定的局部数组 */
+		template<class TrivialDestructor>
+		void __erase_without_rebalance(base_ptr x, TrivialDestructor);
+
+		/* 由 [first, first + n) 建立一棵完全平衡的子树，前进 first，传回子树的根（不设置根的 parent）。
+		   depth 为子树的根在整棵树中的深度，深度为 red_depth 的节点染为红色，其余为黑色 */
+		template<class InputIterator>
+		node_pointer __build_sorted(InputIterator& first, size_type n, size_type depth, size_type red_depth);
+
+		/* [first, last) 是否已排序：strict 为 true 时要求严格递增，否则要求非递减 */
+		template<class ForwardIterator>
+		bool __is_sorted(ForwardIterator first, ForwardIterator last, bool strict) const;
+
+		/* 树为空且输入已排序时，直接以 assign_sorted 建树。只遍历一次的迭代器无法先检查再建树 */
+		template<class InputIterator>
+		bool __try_assign_sorted(InputIterator first, InputIterator last, bool strict) {
+			typedef typename iterator_traits<InputIterator>::iterator_category category;
+			return __try_assign_sorted(first, last, strict, typename __rb_tree_multipass<category>::type());
+		}
+		template<class InputIterator>
+		bool __try_assign_sorted(InputIterator, InputIterator, bool, __false_type) { return false; }
+		template<class ForwardIterator>
+		bool __try_assign_sorted(ForwardIterator first, ForwardIterator last, bool strict, __true_type) {
+			if (!empty() || !__is_sorted(first, last, strict))
+				return false;
+			assign_sorted(first, last);
+			return true;
+		}
+
 		/* 删除节点 x，并进行相应的调整 */
 		void __erase_node(node_pointer x);
 
 		//删除时组合2比较复杂，这里单独使用一个函数来处理
 		void __erase_node_case2_reblance(node_pointer x);
 
+		//x有两个儿子时，将x与其后继y在树中的位置（连同颜色）互换，只改动指针而不移动元素值
+		void __swap_with_successor(node_pointer x, node_pointer y);
+
+		/* 在以 x 为根的子树中寻找第一个键值不小于（大于）k 的节点，找不到时传回 y */
+		node_pointer __lower_bound(node_pointer x, node_pointer y, const Key& k) const {
+			while (x != nullptr) {
+				if (!key_compare(key(x), k))
+					y = x, x = left(x);		//x 键值不小于 k，x 可能就是解答，再往左找更小的
+				else
+					x = right(x);
+			}
+			return y;
+		}
+		node_pointer __upper_bound(node_pointer x, node_pointer y, const Key& k) const {
+			while (x != nullptr) {
+				if (key_compare(k, key(x)))
+					y = x, x = left(x);		//x 键值大于 k，x 可能就是解答，再往左找更小的
+				else
+					x = right(x);
+			}
+			return y;
+		}
+
 
 		void init() {
 			header = get_node();			//产生一个节点作为header
-			color(header) = __rb_tree_red;	//令header为红色，用来区分header和root，在iterator.operator--中使用
-			root() = nullptr;				//root 为空，即 header->parent
+			//令header为红色，用来区分header和root，在iterator.operator--中使用；root 为空，即 header 的父节点为空
+			header->set_parent_and_color(nullptr, __rb_tree_red);
 			leftmost() = header;			//令 header 的左右子节点为自己
 			rightmost() = header;		
 		}
@@ -325,11 +493,11 @@ namespace detail {
 		/* 清空 rb_tree(除header) */
 		void clear();
 
-		/* 将树*this和x交换，只需要交换header指针即可 */
+		/* 将树*this和x交换，只需要交换header指针、节点数量和比较准则即可 */
 		void swap(self& x) {
-			node_pointer tmp = header;
-			*(&header) = x.header;
-			*(&(x.header)) = tmp;
+			lfp::swap(header, x.header);
+			lfp::swap(node_count, x.node_count);
+			lfp::swap(key_compare, x.key_compare);
 		}
 
 		/* 寻找RB_tree中是否存在键值为 k 的节点 */
@@ -343,26 +511,17 @@ namespace detail {
 
 		/* 统计元素x的个数 */
 		size_type count(const key_type& x) const {
-			size_type x_count = 0;
-			const_iterator it = find(x);		//当有多个相同元素时，find 返回第一个元素的迭代器
-
-			if (it != end()) {
-				++x_count;
-				
-				//向后遍历查看是否还存在键值为key的元素
-				while (++it != end()) {
-					if (!key_compare(x, key(it.node)) && !key_compare(key(it.node), x))	 // !(a<b) && !(b<a) 即 a==b
-						++x_count;
-					else
-						break;
-				}
-			}
-			return x_count;
+			std::pair<const_iterator, const_iterator> p = equal_range(x);
+#ifdef __STL_RB_TREE_ORDER_STATISTICS
+			return size_type(distance(p.first, p.second));
+#else
+			return size_type(lfp::distance(p.first, p.second));
+#endif
 		}
 
 		Compare key_comp() const { return key_compare; }
-		iterator begin() { return leftmost(); }		//第一个节点即 left-most
-		const_iterator begin() const { return leftmost(); }
+		iterator begin() { return (node_pointer)leftmost(); }		//第一个节点即 left-most
+		const_iterator begin() const { return (node_pointer)leftmost(); }
 		iterator end() { return header; }			//end即header
 		const_iterator end() const { return header; }
 		bool empty() const { return (node_count == 0); }
@@ -373,84 +532,175 @@ namespace detail {
 		/* 插入新值：键值不允许重复，重复则插入失败 */
 		std::pair<iterator, bool> insert_unique(const value_type& v);
 
+		/* 以 position 为提示插入新值，新值应紧邻 position 之前（或之后），如按序追加时以 end() 为提示，
+		   此时均摊常数时间。返回指向新增节点或与之重复的节点的迭代器 */
+		iterator insert_unique(const_iterator position, const value_type& v) {
+			std::pair<base_ptr, base_ptr> pos = __insert_hint_unique_pos(position, KeyOfValue()(v));
+			if (pos.second == nullptr)
+				return iterator((node_pointer)pos.first);
+			return __insert(pos.first, pos.second, create_node(v));
+		}
+
+		//以 end() 为提示逐个插入，已排序的区间只需线性时间
 		template<class InputIterator>
 		void insert_unique(InputIterator first, InputIterator last) {
+			if (__try_assign_sorted(first, last, true))
+				return;
 			while (first != last) {
-				insert_unique(*first);
+				insert_unique(end(), *first);
 				++first;
 			}
 		}
 
 		/* 插入新值：键值允许重复 */
-		iterator insert_equal(const value_type& v);
+		iterator insert_equal(const value_type& v) {
+			std::pair<base_ptr, base_ptr> pos = __insert_equal_pos(KeyOfValue()(v));
+			return __insert(pos.first, pos.second, create_node(v));
+		}
+
+		iterator insert_equal(const_iterator position, const value_type& v) {
+			std::pair<base_ptr, base_ptr> pos = __insert_hint_equal_pos(position, KeyOfValue()(v));
+			return __insert(pos.first, pos.second, create_node(v));
+		}
 
 		template<class InputIterator>
 		void insert_equal(InputIterator first, InputIterator last) {
+			if (__try_assign_sorted(first, last, false))
+				return;
 			while (first != last) {
-				insert_equal(*first);
+				insert_equal(end(), *first);
 				++first;
 			}
 		}
 
+		/* 以 args 就地构造新值再插入，键值不允许重复时先构造节点、再以其键值寻找插入点，重复则销毁 */
+		template<class... Args>
+		std::pair<iterator, bool> emplace_unique(Args&&... args) {
+			node_pointer z = create_node(std::forward<Args>(args)...);
+			std::pair<base_ptr, base_ptr> pos;
+			try {
+				pos = __insert_unique_pos(key(z));
+			}
+			catch (...) {
+				destroy_node(z);
+				throw;
+			}
+			return __insert_node_unique(pos, z);
+		}
+		template<class... Args>
+		iterator emplace_hint_unique(const_iterator position, Args&&... args) {
+			node_pointer z = create_node(std::forward<Args>(args)...);
+			std::pair<base_ptr, base_ptr> pos;
+			try {
+				pos = __insert_hint_unique_pos(position, key(z));
+			}
+			catch (...) {
+				destroy_node(z);
+				throw;
+			}
+			return __insert_node_unique(pos, z).first;
+		}
+		template<class... Args>
+		iterator emplace_equal(Args&&... args) {
+			node_pointer z = create_node(std::forward<Args>(args)...);
+			std::pair<base_ptr, base_ptr> pos;
+			try {
+				pos = __insert_equal_pos(key(z));
+			}
+			catch (...) {
+				destroy_node(z);
+				throw;
+			}
+			return __insert(pos.first, pos.second, z);
+		}
+		template<class... Args>
+		iterator emplace_hint_equal(const_iterator position, Args&&... args) {
+			node_pointer z = create_node(std::forward<Args>(args)...);
+			std::pair<base_ptr, base_ptr> pos;
+			try {
+				pos = __insert_hint_equal_pos(position, key(z));
+			}
+			catch (...) {
+				destroy_node(z);
+				throw;
+			}
+			return __insert(pos.first, pos.second, z);
+		}
+
+		/* 以已排序的 [first, last) 取代树中原有的元素，线性时间建立一棵完全平衡的树，不做任何比较和旋转。
+		   调用者须保证区间已排序，用于 insert_unique 的树还须保证没有重复的键值 */
+		template<class ForwardIterator>
+		void assign_sorted(ForwardIterator first, ForwardIterator last);
+
 		/* 删除节点 x */
 		void erase(node_pointer x) { __erase_node(x); }
 		void erase(iterator x) { __erase_node(node_pointer(x.node)); }
+		void erase(const_iterator x) { __erase_node(node_pointer(x.node)); }		//set 的迭代器即 const_iterator
 		size_type erase(const Key& x) {
-			iterator it = find(x);
-			size_type count = 0;
-
-			while (it != end()) {
-				__erase_node(node_pointer(it.node));
-				it = find(x);
-				++count;
-			}
-
-			return count;
+			std::pair<iterator, iterator> p = equal_range(x);
+			size_type n = size_type(lfp::distance(p.first, p.second));
+			erase(p.first, p.second);
+			return n;
 		}
-		void erase(iterator first, iterator last) {
+		//删除节点不会移动其他节点的元素值，因此被删除节点之外的迭代器都保持有效
+		void erase(const_iterator first, const_iterator last) {
+			if (first == begin() && last == end()) {
+				clear();
+				return;
+			}
 			while (first != last) {
-				iterator tmp = first++;
+				const_iterator tmp = first++;
 				erase(tmp);
 			}
 		}
 
-		iterator lower_bound(const key_type& x) { return lower_bound(begin(), end(), x); }
-		const_iterator lower_bound(const key_type& x) const { return lower_bound(begin(), end(), x); }
-		iterator upper_bound(const key_type& x) { return upper_bound(begin(), end(), x); }
-		const_iterator upper_bound(const key_type& x) const { return upper_bound(begin(), end(), x); }
+		/* 以下均只需从根节点往下走一趟，时间复杂度 O(log n) */
+		//第一个键值不小于 x 的元素
+		const_iterator lower_bound(const key_type& x) const { return const_iterator(__lower_bound((node_pointer)root(), header, x)); }
+		iterator lower_bound(const key_type& x) { return iterator(__lower_bound((node_pointer)root(), header, x)); }
+		//第一个键值大于 x 的元素
+		const_iterator upper_bound(const key_type& x) const { return const_iterator(__upper_bound((node_pointer)root(), header, x)); }
+		iterator upper_bound(const key_type& x) { return iterator(__upper_bound((node_pointer)root(), header, x)); }
 
-		/* 返回元素 x 的区间 */
+		/* 返回键值等于 x 的元素区间 [lower_bound, upper_bound) */
+		std::pair<const_iterator, const_iterator> equal_range(const key_type& x) const;
 		std::pair<iterator, iterator> equal_range(const key_type& x) {
-			iterator first = find(x);
-			iterator last = find(x);
-			while (last != end()) {
-				if (!key_compare(x, key(last.node)) && !key_compare(key(last.node), x))
-					++last;
-				else
-					break;
-			}
+			std::pair<const_iterator, const_iterator> p = static_cast<const self&>(*this).equal_range(x);
+			return std::pair<iterator, iterator>(iterator(node_pointer(p.first.node)), iterator(node_pointer(p.second.node)));
+		}
 
-			return std::pair<iterator, iterator>(first, last);
+#ifdef __STL_RB_TREE_ORDER_STATISTICS
+		/* 以下利用子树大小，时间复杂度均为 O(log n) */
+		//第 k 个元素（从0开始计），k >= size() 时传回 end()
+		const_iterator nth(size_type k) const;
+		iterator nth(size_type k) { return iterator(node_pointer(static_cast<const self&>(*this).nth(k).node)); }
+		//键值小于 x 的元素个数，也就是 lower_bound(x) 的位置
+		size_type rank(const key_type& x) const;
+		//it 所指元素的位置，end() 的位置为 size()
+		size_type index_of(const_iterator it) const;
+		difference_type distance(const_iterator first, const_iterator last) const {
+			return difference_type(index_of(last)) - difference_type(index_of(first));
 		}
+#endif
 	};
 
 
 
 	/* 拷贝赋值运算符 */
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	rb_tree<Key, Value, KeyOfValue, Compare, Alloc>&
-	rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::operator=(const self& x) {
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>&
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::operator=(const self& x) {
 		clear();		//先将原始的树清空
 
 		key_compare = x.key_compare;
-		header->parent = __copy(x.root());
-		if (header->parent != nullptr)
+		set_root(__copy((node_pointer)x.root()));
+		if (root() != nullptr)
 		{
-			root()->parent = header;
+			root()->set_parent(header);
 			node_count = x.node_count;
 
-			leftmost() = get_min_node(root());
-			rightmost() = get_max_node(root());
+			leftmost() = __rb_tree_node_base::get_min_node(root());
+			rightmost() = __rb_tree_node_base::get_max_node(root());
 		}
 
 		return *this;
@@ -458,39 +708,114 @@ namespace detail {
 
 
 	/* 清空rb_tree(除header) */
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::clear()
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::clear()
 	{
-		if (header->parent != nullptr) {
-			queue<base_ptr> node_queue;
-
-			node_queue.push(header->parent);
-			while (!node_queue.empty()) {
-				base_ptr cur = node_queue.front();
-				node_queue.pop();
-				
-				if (cur->left != nullptr)
-					node_queue.push(cur->left);
-				if (cur->right != nullptr)
-					node_queue.push(cur->right);
-				destroy_node(node_pointer(cur));
-			}
+		if (root() != nullptr) {
+			typedef typename __type_traits<value_type>::has_trivial_destructor trivial_destructor;
+			__erase_without_rebalance(root(), trivial_destructor());
 
 			/* 将 rb_tree 恢复到空状态 */
 			node_count = 0;
-			root() = nullptr;		//root 为空，即 header->parent
+			set_root(nullptr);		//root 为空，即 header 的父节点为空
 			leftmost() = header;	//令 header 的左右子节点为自己
 			rightmost() = header;
 		}
 	}
 
 
+	/* 以已排序的 [first, last) 取代树中原有的元素 */
+	/* n 个节点按中序对半划分：前 (n-1)/2 个建左子树，接着一个作根，其余建右子树，两侧大小至多差一。
+	   这样的树除最底一层外都是满的，最底一层（深度为 floor(log2(n))）染红、其余染黑，
+	   每条路径上的黑节点数就都相同；n 恰好为 2^k - 1 时最底一层也是满的，全部染黑亦可，这里统一处理。
+	   节点按键值顺序依次配置，内存池每次补充的一批节点是连续的，因此中序相邻的节点在内存中也大多相邻 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	template<class ForwardIterator>
+	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::assign_sorted(ForwardIterator first, ForwardIterator last) {
+		clear();
+		size_type n = 0;		//不用 lfp::distance：迭代器也可能来自标准库，其种类标签不是本库的
+		for (ForwardIterator it = first; it != last; ++it)
+			++n;
+		if (n == 0)
+			return;
+
+		size_type red_depth = 0;
+		for (size_type m = n; m > 1; m >>= 1)
+			++red_depth;
+		if (red_depth == 0)
+			red_depth = size_type(-1);		//只有一个节点，即根节点，必须为黑色
+
+		set_root(__build_sorted(first, n, 0, red_depth));
+		root()->set_parent(header);
+		leftmost() = __rb_tree_node_base::get_min_node(root());
+		rightmost() = __rb_tree_node_base::get_max_node(root());
+		node_count = n;
+	}
+
+	/* 由 [first, first + n) 建立一棵完全平衡的子树。构造元素抛出异常时销毁已建好的部分 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	template<class InputIterator>
+	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::node_pointer
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__build_sorted(InputIterator& first, size_type n,
+																		 size_type depth, size_type red_depth) {
+		if (n == 0)
+			return nullptr;
+
+		size_type nl = (n - 1) / 2;
+		node_pointer l = __build_sorted(first, nl, depth + 1, red_depth);
+		node_pointer x;
+		try {
+			x = create_node(*first);
+		}
+		catch (...) {
+			__erase_without_rebalance(l, __false_type());
+			throw;
+		}
+		++first;
+		x->set_parent_and_color(nullptr, (depth == red_depth) ? __rb_tree_red : __rb_tree_black);
+		x->left = l;
+		x->right = nullptr;
+		try {
+			x->right = __build_sorted(first, n - nl - 1, depth + 1, red_depth);
+		}
+		catch (...) {
+			__erase_without_rebalance(x, __false_type());
+			throw;
+		}
+
+		if (x->left != nullptr)
+			x->left->set_parent(x);
+		if (x->right != nullptr)
+			x->right->set_parent(x);
+		Augment::update(x);
+		return x;
+	}
+
+	/* [first, last) 是否已排序 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	template<class ForwardIterator>
+	bool rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__is_sorted(ForwardIterator first, ForwardIterator last,
+																		   bool strict) const {
+		if (first == last)
+			return true;
+		ForwardIterator next = first;
+		while (++next != last) {
+			const value_type& a = *first;		//*first 可能是需要转换的临时对象（如 map 的 pair），绑定到引用以延长其生命期
+			const value_type& b = *next;
+			if (strict ? !key_compare(KeyOfValue()(a), KeyOfValue()(b)) : key_compare(KeyOfValue()(b), KeyOfValue()(a)))
+				return false;
+			first = next;
+		}
+		return true;
+	}
+
+
 	/* 寻找RB_tree中是否存在键值为 k 的节点 */
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::const_iterator
-	rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::find(const Key& k) const {
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::const_iterator
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::find(const Key& k) const {
 		node_pointer y = header;
-		node_pointer x = root();
+		node_pointer x = (node_pointer)root();
 
 		//注意：当存在相同元素时，find 返回第一个元素的迭代器（递增迭代器可访问其他相同元素）
 
@@ -517,74 +842,246 @@ namespace detail {
 	}
 
 
+	/* 返回键值等于 k 的元素区间 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::const_iterator,
+			  typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::const_iterator>
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::equal_range(const Key& k) const {
+		node_pointer y = header;
+		node_pointer x = (node_pointer)root();
+
+		while (x != nullptr) {
+			if (key_compare(key(x), k))
+				x = right(x);
+			else if (key_compare(k, key(x)))
+				y = x, x = left(x);
+			else {
+				//找到一个等于 k 的节点后分头进行：左子树中找下界，右子树中找上界
+				return std::pair<const_iterator, const_iterator>(const_iterator(__lower_bound(left(x), x, k)),
+																 const_iterator(__upper_bound(right(x), y, k)));
+			}
+		}
+		return std::pair<const_iterator, const_iterator>(const_iterator(y), const_iterator(y));
+	}
+
+
+#ifdef __STL_RB_TREE_ORDER_STATISTICS
+	/* 第 k 个元素：左子树大小 l 即为当前节点的位置，k < l 往左走，k > l 则减去 l + 1 往右走 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::const_iterator
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::nth(size_type k) const {
+		if (k >= node_count)
+			return end();
+		base_ptr x = root();
+		for (;;) {
+			size_type l = subtree_size(x->left);
+			if (k < l)
+				x = x->left;
+			else if (k == l)
+				return const_iterator((node_pointer)x);
+			else {
+				k -= l + 1;
+				x = x->right;
+			}
+		}
+	}
+
+	/* 键值小于 k 的元素个数：每向右走一步，就累加当前节点及其左子树的大小 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::size_type
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::rank(const Key& k) const {
+		size_type r = 0;
+		base_ptr x = root();
+		while (x != nullptr) {
+			if (key_compare(key(x), k)) {
+				r += subtree_size(x->left) + 1;
+				x = x->right;
+			}
+			else
+				x = x->left;
+		}
+		return r;
+	}
+
+	/* 元素的位置：从节点往上走到根，每当自己是右子节点，就累加父节点及其左子树的大小 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::size_type
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::index_of(const_iterator it) const {
+		base_ptr x = it.node;
+		if (x == header)
+			return node_count;
+		size_type r = subtree_size(x->left);
+		for (; x != root(); x = x->parent()) {
+			if (x == x->parent()->right)
+				r += subtree_size(x->parent()->left) + 1;
+		}
+		return r;
+	}
+#endif
+
+
 	/* 插入新值：节点值不允许重复，重复则插入无效 */
 	/* 返回一个pair，第一个元素指向RB_tree中新增节点，第二个元素表示是否插入成功 */
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator, bool>
-	rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(const value_type& v) {
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator, bool>
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::insert_unique(const value_type& v) {
+		std::pair<base_ptr, base_ptr> pos = __insert_unique_pos(KeyOfValue()(v));
+
+		/* 键值重复，插入失败 */
+		/* 注意：这里有个技巧是返回一个第一元素指向发生冲突 */
+		/* 的节点的迭代器，在map的下标操作中起了重要的作用 */
+		if (pos.second == nullptr)
+			return std::pair<iterator, bool>(iterator((node_pointer)pos.first), false);
+		return std::pair<iterator, bool>(__insert(pos.first, pos.second, create_node(v)), true);
+	}
+
+	/* 寻找键值 k 的插入点（不允许重复） */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::base_ptr,
+			  typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::base_ptr>
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__insert_unique_pos(const Key& k) {
+		typedef std::pair<base_ptr, base_ptr> pos_type;
 		node_pointer y = header;
-		node_pointer x = root();
+		node_pointer x = (node_pointer)root();
 		bool comp = true;
 
 		while (x != nullptr) {		//从根节点开始，向下寻找适当的插入点
 			y = x;
 
-			comp = key_compare(KeyOfValue()(v), key(x));		//less
+			comp = key_compare(k, key(x));		//less
 			x = comp ? left(x) : right(x);
 		} //结束后，x指向插入点，y指向x的父节点
 
 		iterator j = iterator(y);
 
-		/* 如果comp为真，表示 v < x */
+		/* 如果comp为真，表示 k < y */
 		if (comp) {
 			if (j == begin())	//如果插入节点的父节点为 left_most，则直接插入
-				return std::pair<iterator, bool>(__insert(x, y, v), true);
+				return pos_type(x, y);
 			else		//否则将调整 j 用于后面测试
 				--j;
 		}
-		/* 如果comp为假，表示 v >= x，如果是 v > x 则进行插入 */
-		if (key_compare(key(j.node), KeyOfValue()(v))) {
-			return std::pair<iterator, bool>(__insert(x, y, v), true);
-		}
+		/* 此时 j 是不大于 k 的最大节点，如果是 j < k 则可以插入 */
+		if (key_compare(key(j.node), k))
+			return pos_type(x, y);
 
-		/* 进行到这里，键值一定重复，插入失败 */
-		/* 注意：这里有个技巧是返回一个第一元素指向发生冲突 */
-		/* 的节点的迭代器，在map的下标操作中起了重要的作用 */
-		return std::pair<iterator, bool>(j, false);
+		/* 进行到这里，键值一定重复 */
+		return pos_type(j.node, nullptr);
 	}
 
-	/* 插入新值：节点值允许重复 */
-	/* 返回指向新插入节点的迭代器 */
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
-	rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_equal(const value_type& v) {
+	/* 寻找键值 k 的插入点（允许重复） */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::base_ptr,
+			  typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::base_ptr>
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__insert_equal_pos(const Key& k) {
 
 		/* 注意：当插入相同元素时，新元素成为已有元素的后继（即已有元素右孩子的最左节点） */
 
 		node_pointer y = header;
-		node_pointer x = root();		//从根节点开始往下寻找适当的插入点
+		node_pointer x = (node_pointer)root();		//从根节点开始往下寻找适当的插入点
 		while (x != nullptr) {
 			y = x;
-			x = key_compare(KeyOfValue()(v), key(x)) ? left(x) : right(x);		//less
+			x = key_compare(k, key(x)) ? left(x) : right(x);		//less
 		}
-		return __insert(x, y, v);
-		// x为新值插入点，y为插入点的父节点，v为待插入值
+		return std::pair<base_ptr, base_ptr>(x, y);
+		// x为新值插入点，y为插入点的父节点
 	}
 
+	/* 以 position 为提示寻找键值 k 的插入点（不允许重复） */
+	/* 传回 (y, y) 表示作为 y 的左子节点插入（此时 y 一定没有左子节点），(nullptr, y) 表示作为 y 的右子节点插入 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::base_ptr,
+			  typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::base_ptr>
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__insert_hint_unique_pos(const_iterator position, const Key& k) {
+		typedef std::pair<base_ptr, base_ptr> pos_type;
+		base_ptr p = position.node;
+
+		if (p == header) {		//提示为 end()：比最大值还大时直接接在 right-most 之后，即按序追加
+			if (node_count > 0 && key_compare(key(rightmost()), k))
+				return pos_type(nullptr, rightmost());
+			return __insert_unique_pos(k);
+		}
+		if (key_compare(k, key(p))) {		//k 在 p 之前，看是否也在 p 的前驱之后
+			if (p == leftmost())
+				return pos_type(p, p);
+			const_iterator before = position;
+			--before;
+			if (key_compare(key(before.node), k)) {
+				//p 有左子树时前驱是左子树的最右节点，没有右子节点；否则 p 没有左子节点
+				if (before.node->right == nullptr)
+					return pos_type(nullptr, before.node);
+				return pos_type(p, p);
+			}
+			return __insert_unique_pos(k);
+		}
+		if (key_compare(key(p), k)) {		//k 在 p 之后，看是否也在 p 的后继之前
+			if (p == rightmost())
+				return pos_type(nullptr, p);
+			const_iterator after = position;
+			++after;
+			if (key_compare(k, key(after.node))) {
+				if (p->right == nullptr)
+					return pos_type(nullptr, p);
+				return pos_type(after.node, after.node);
+			}
+			return __insert_unique_pos(k);
+		}
+		return pos_type(p, nullptr);		//键值与 p 重复
+	}
 
-	/* 真正的插入程序: x为新值插入点，y为插入点的父节点，v为待插入值。返回指向新插入节点的迭代器 */
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
-	rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__insert(base_ptr _x, base_ptr _y, const value_type& v) {
+	/* 以 position 为提示寻找键值 k 的插入点（允许重复），传回值的含义同上 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::base_ptr,
+			  typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::base_ptr>
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__insert_hint_equal_pos(const_iterator position, const Key& k) {
+		typedef std::pair<base_ptr, base_ptr> pos_type;
+		base_ptr p = position.node;
+
+		if (p == header) {		//提示为 end()：不小于最大值时直接接在 right-most 之后
+			if (node_count > 0 && !key_compare(k, key(rightmost())))
+				return pos_type(nullptr, rightmost());
+			return __insert_equal_pos(k);
+		}
+		if (!key_compare(key(p), k)) {		//k 不大于 p，看是否也不小于 p 的前驱
+			if (p == leftmost())
+				return pos_type(p, p);
+			const_iterator before = position;
+			--before;
+			if (!key_compare(k, key(before.node))) {
+				if (before.node->right == nullptr)
+					return pos_type(nullptr, before.node);
+				return pos_type(p, p);
+			}
+			return __insert_equal_pos(k);
+		}
+		//k 大于 p，看是否也不大于 p 的后继
+		if (p == rightmost())
+			return pos_type(nullptr, p);
+		const_iterator after = position;
+		++after;
+		if (!key_compare(key(after.node), k)) {
+			if (p->right == nullptr)
+				return pos_type(nullptr, p);
+			return pos_type(after.node, after.node);
+		}
+		return __insert_equal_pos(k);
+	}
+
+
+	/* 真正的插入程序: x为新值插入点，y为插入点的父节点，z为已生成的新节点。返回指向新插入节点的迭代器 */
+	/* x 不为空时（由提示插入传来）一定作为 y 的左子节点插入 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::iterator
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__insert(base_ptr _x, base_ptr _y, node_pointer z) {
 		node_pointer x = (node_pointer)_x;
 		node_pointer y = (node_pointer)_y;
 
-		node_pointer new_node = create_node(v);			//产生一个新节点
-		if (y == header || x != 0 || key_compare(KeyOfValue()(v), key(y)))
+		node_pointer new_node = z;
+		if (y == header || x != 0 || key_compare(key(z), key(y)))
 		{
-			left(y) = new_node;		//这使得当y为header时，leftmost() = new_node
+			y->left = new_node;		//这使得当y为header时，leftmost() = new_node
 			if (y == header) {
-				root() = new_node;
+				set_root(new_node);
 				rightmost() = new_node;
 			}
 			else if (y == leftmost()) {
@@ -592,25 +1089,57 @@ namespace detail {
 			}
 		}
 		else {
-			right(y) = new_node;		//令新节点为插入点父节点的右子节点
+			y->right = new_node;		//令新节点为插入点父节点的右子节点
 			if (y == rightmost()) {
 				rightmost() = new_node;		//维护 rightmost 永远指向最右节点
 			}
 		}
-		parent(new_node) = y;		//设定新节点的父节点
-		left(new_node) = 0;
-		right(new_node) = 0;		//设定新节点的左右子节点
+		new_node->set_parent_and_color(y, __rb_tree_red);		//设定新节点的父节点，新节点必为红
+		new_node->left = nullptr;
+		new_node->right = nullptr;		//设定新节点的左右子节点
+
+		//先更新新节点到根节点路径上的附加信息，之后的旋转只需要维护两个旋转点
+		__rb_tree_augment_path<Augment>(new_node, header);
 
 		//节点颜色一定为红，将在全局函数__rb_tree_rebalance() 中设定并调整
-		__rb_tree_rebalance(new_node, header->parent);		//参数一为新增节点，参数二为 root
+		__rb_tree_rebalance<Augment>(new_node, header);		//参数一为新增节点，参数二为 header
 		++node_count;
 		return iterator(new_node);		//返回指向新增节点的迭代器
 	}
 
+	/* 销毁以 x 为根的整棵子树 */
+	/* 先序遍历：销毁当前节点后沿左子节点往下走，右子节点暂存在 pending 中，左链走完后再取出。
+	   pending 中同时存在的右子节点不超过树高，红黑树的高度不超过 2log(n+1)，因此一个固定大小的
+	   局部数组就够用，整个过程不配置任何空间。暂存右子节点时顺便预取，等轮到它时多半已经在 cache 中 */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	template<class TrivialDestructor>
+	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__erase_without_rebalance(base_ptr x, TrivialDestructor) {
+		base_ptr pending[2 * 8 * sizeof(size_type)];
+		int top = 0;
+		for (;;) {
+			while (x != nullptr) {
+				base_ptr l = x->left;
+				base_ptr r = x->right;
+				release_node((node_pointer)x, TrivialDestructor());
+				if (l != nullptr && r != nullptr) {
+					__builtin_prefetch(r);
+					pending[top++] = r;
+					x = l;
+				}
+				else {
+					x = (l != nullptr) ? l : r;
+				}
+			}
+			if (top == 0)
+				break;
+			x = pending[--top];
+		}
+	}
+
 	/* 复制整棵树 x */
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::node_pointer
-	rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__copy(node_pointer x) {
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::node_pointer
+	rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__copy(node_pointer x) {
 		if (x == nullptr)
 			return nullptr;
 
@@ -619,9 +1148,10 @@ namespace detail {
 		x_copy->right = __copy(right(x));
 
 		if (x_copy->left != nullptr)
-			x_copy->left->parent = x_copy;
+			x_copy->left->set_parent(x_copy);
 		if (x_copy->right != nullptr)
-			x_copy->right->parent = x_copy;
+			x_copy->right->set_parent(x_copy);
+		Augment::update(x_copy);
 
 		return x_copy;
 	}
@@ -630,21 +1160,21 @@ namespace detail {
 	//以下算法的具体过程请看这里：https://blog.csdn.net/qq_40843865/article/details/102498310
 
 	/* 删除节点 x，并进行相应的调整 */
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__erase_node(node_pointer x)
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__erase_node(node_pointer x)
 	{
 		if (x->left == nullptr && x->right == nullptr)	//删除叶节点
 		{
-			if (x->color == __rb_tree_red)		//组合1：删除红色的叶节点，直接删除即可（因为红节点不可能是root）
+			if (x->color() == __rb_tree_red)		//组合1：删除红色的叶节点，直接删除即可（因为红节点不可能是root）
 			{
 				if (leftmost() == x)
-					leftmost() = (node_pointer)x->parent;
+					leftmost() = (node_pointer)x->parent();
 				else if (rightmost() == x)
-					rightmost() = (node_pointer)x->parent;
+					rightmost() = (node_pointer)x->parent();
 			}
 			else {									//组合2：最麻烦的情况
 				if (root() == x) {	//删除根节点
-					root() = nullptr;
+					set_root(nullptr);
 					leftmost() = header;
 					rightmost() = header;
 				}
@@ -652,108 +1182,156 @@ namespace detail {
 					__erase_node_case2_reblance(x);
 
 					if (leftmost() == x)
-						leftmost() = (node_pointer)x->parent;
+						leftmost() = (node_pointer)x->parent();
 					if (rightmost() == x)
-						rightmost() = (node_pointer)x->parent;
+						rightmost() = (node_pointer)x->parent();
 				}
 			}
 
-			if (x->parent->left == x)
-				x->parent->left = nullptr;
+			if (x->parent()->left == x)
+				x->parent()->left = nullptr;
 			else
-				x->parent->right = nullptr;
+				x->parent()->right = nullptr;
 
+			__rb_tree_augment_path<Augment>(x->parent(), header);
 			destroy_node(x);
 			--node_count;
 		}
 		else if (x->left == nullptr) {		//一定是组合4：x是黑节点，它的右孩子是红节点（因为组合3不可能存在）
 			node_pointer son = (node_pointer)x->right;
-			son->parent = x->parent;
-			son->color = __rb_tree_black;
+			son->set_parent(x->parent());
+			son->set_color(__rb_tree_black);
 
-			if (x->parent->left == x)
-				x->parent->left = son;
+			if (x->parent()->left == x)
+				x->parent()->left = son;
 			else
-				x->parent->right = son;
+				x->parent()->right = son;
 
 			if (root() == x) {		//如果删除的是root节点，一点要调整相关指针
-				root() = son;
+				set_root(son);
 			}
 			if (leftmost() == x)
 				leftmost() = son;
 
+			__rb_tree_augment_path<Augment>(son->parent(), header);
 			destroy_node(x);
 			--node_count;
 		}
 		else if (x->right == nullptr) {		//一定是组合4：x是黑节点，它的左孩子是红节点（因为组合3不可能存在）
 			node_pointer son = (node_pointer)x->left;
-			son->parent = x->parent;
-			son->color = __rb_tree_black;
+			son->set_parent(x->parent());
+			son->set_color(__rb_tree_black);
 
-			if (x->parent->left == x)
-				x->parent->left = son;
+			if (x->parent()->left == x)
+				x->parent()->left = son;
 			else
-				x->parent->right = son;
+				x->parent()->right = son;
 			
 			if (root() == x) {		//如果删除的是root节点，一点要调整相关指针
-				root() = son;
+				set_root(son);
 			}
 			if (rightmost() == x)
 				rightmost() = son;
 
+			__rb_tree_augment_path<Augment>(son->parent(), header);
 			destroy_node(x);
 			--node_count;
 		}
 		else {								//组合5、6：x有两个儿子
-			iterator it = iterator(x);
-			++it;	//这里找x的后继，也可以找x的前驱
+			//将x与其后继（右子树的最左节点）交换位置，x随之至多只有一个儿子，会回到组合1 2 4中的一种
+			//这里交换的是节点本身而不是元素值：元素不必可以赋值，指向其他元素的迭代器也不会失效
+			__swap_with_successor(x, get_min_node(right(x)));
+			__erase_node(x);
+		}
+	}
+
+	/* 将x与其后继y的位置互换，y为x右子树的最左节点（y没有左儿子） */
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__swap_with_successor(node_pointer x, node_pointer y) {
+		base_ptr xp = x->parent();
 
-			memmove(&(x->value_field), &(((node_pointer)it.node)->value_field), sizeof(x->value_field));
-			//x->value_field = *it;  //std::pair deleted operator=
+		//y接收x的左子树
+		y->left = x->left;
+		y->left->set_parent(y);
+		x->left = nullptr;
 
-			__erase_node((node_pointer)it.node);	//转化为删除节点x的后继，会回到组合1 2 4中的一种
+		if (y == x->right) {		//y是x的右儿子：x成为y的右儿子
+			x->right = y->right;
+			y->right = x;
+			x->set_parent(y);
+		}
+		else {						//y在更深处：x移到y原来的位置，成为y原父节点的左儿子
+			base_ptr yr = y->right;
+			y->right = x->right;
+			y->right->set_parent(y);
+			x->right = yr;
+			x->set_parent(y->parent());
+			x->parent()->left = x;
 		}
+		if (x->right != nullptr)
+			x->right->set_parent(x);
+
+		//y接替x与其父节点的关系
+		y->set_parent(xp);
+		if (root() == x)
+			set_root(y);
+		else if (xp->left == x)
+			xp->left = y;
+		else
+			xp->right = y;
+
+		color_type c = x->color();
+		x->set_color(y->color());
+		y->set_color(c);
+		//x有两个儿子，不可能是最左、最右节点；y可能是最右节点，此时x接替它
+		if (rightmost() == y)
+			rightmost() = x;
+
+		//x到根节点的路径经过y的新位置，其余节点的子树没有变化
+		__rb_tree_augment_path<Augment>(x, header);
 	}
 
 	/* 组合2处理函数（这里只是进行旋转或者变色，并不删除节点） */
 	// 这里传入的x在算法思路上我们认为它含有一个额外的黑色权重，且x一定有brother节点
-	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc>
-	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__erase_node_case2_reblance(node_pointer x) {
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc, class Augment>
+	void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, Augment>::__erase_node_case2_reblance(node_pointer x) {
+		if (x == root())	//情形3.2递归到根节点时结束，根节点没有兄弟节点
+			return;
 		node_pointer brother = (node_pointer)x->get_brother();
 
-		if (brother->color == __rb_tree_black)		//情形一 二 三
+		if (brother->color() == __rb_tree_black)		//情形一 二 三
 		{
-			if ((brother->left && brother->left->color == __rb_tree_red) ||		//情形一 二
-				(brother->right && brother->right->color == __rb_tree_red))
+			if ((brother->left && brother->left->color() == __rb_tree_red) ||		//情形一 二
+				(brother->right && brother->right->color() == __rb_tree_red))
 			{
-				if (brother == x->parent->right)
+				if (brother == x->parent()->right)
 				{
-					if (brother->right != nullptr) {	//情形一
-						__rb_tree_rotate_left(x->parent, header->parent);
-						brother->right->color = __rb_tree_black;
-						brother->color = x->parent->color;
-						x->parent->color = __rb_tree_black;
+					if (brother->right && brother->right->color() == __rb_tree_red) {	//情形一（递归时 brother 的儿子可能是黑节点，须判断颜色）
+						__rb_tree_rotate_left<Augment>(x->parent(), header);
+						brother->right->set_color(__rb_tree_black);
+						brother->set_color(x->parent()->color());
+						x->parent()->set_color(__rb_tree_black);
 					}
 					else {							//情形二
-						__rb_tree_rotate_right(brother, header->parent);
-						brother->color = __rb_tree_red;
-						brother->parent->color = __rb_tree_black;  //这里brother->parent是原来brother的儿子节点
+						__rb_tree_rotate_right<Augment>(brother, header);
+						brother->set_color(__rb_tree_red);
+						brother->parent()->set_color(__rb_tree_black);  //这里brother->parent是原来brother的儿子节点
 
 						__erase_node_case2_reblance(x);	  //这里回到情形一，递归重新调整
 					}
 				}
-				else	//brother == x->parent->left
+				else	//brother == x->parent()->left
 				{
-					if (brother->left != nullptr) {	  //情形一
-						__rb_tree_rotate_right(x->parent, header->parent);
-						brother->left->color = __rb_tree_black;
-						brother->color = x->parent->color;
-						x->parent->color = __rb_tree_black;
+					if (brother->left && brother->left->color() == __rb_tree_red) {	  //情形一
+						__rb_tree_rotate_right<Augment>(x->parent(), header);
+						brother->left->set_color(__rb_tree_black);
+						brother->set_color(x->parent()->color());
+						x->parent()->set_color(__rb_tree_black);
 					}
 					else {							//情形二
-						__rb_tree_rotate_left(brother, header->parent);
-						brother->color = __rb_tree_red;
-						brother->parent->color = __rb_tree_black;  //这里brother->parent是原来brother的儿子节点
+						__rb_tree_rotate_left<Augment>(brother, header);
+						brother->set_color(__rb_tree_red);
+						brother->parent()->set_color(__rb_tree_black);  //这里brother->parent是原来brother的儿子节点
 
 						__erase_node_case2_reblance(x);	//这里回到情形一，递归重新调整
 					}
@@ -761,17 +1339,15 @@ namespace detail {
 			}
 			else					//情形三
 			{
-				if (x == root())	//递归结束
-					return;
-				if (x->parent->color == __rb_tree_red)	//情形3.1
+				if (x->parent()->color() == __rb_tree_red)	//情形3.1
 				{
-					x->parent->color = __rb_tree_black;
-					brother->color = __rb_tree_red;
+					x->parent()->set_color(__rb_tree_black);
+					brother->set_color(__rb_tree_red);
 				}
 				else {				//情形3.2
-					brother->color = __rb_tree_red;
+					brother->set_color(__rb_tree_red);
 
-					__erase_node_case2_reblance((node_pointer)x->parent);	//对parent递归这个过程（这时parent在算法思想上黑色权重为2）
+					__erase_node_case2_reblance((node_pointer)x->parent());	//对parent递归这个过程（这时parent在算法思想上黑色权重为2）
 
 					//以上将brother子树的黑节点减少一层，将x的黑色权重2（只是在算法思路上存在）移一个到father，
 					//递归这个过程，直至遇到其他情形解决问题或递归到根节点
@@ -780,15 +1356,15 @@ namespace detail {
 		}
 		else				//情形四（brother为红，x->parent一定为黑）
 		{
-			if (brother == x->parent->right) {
-				__rb_tree_rotate_left(x->parent, header->parent);
+			if (brother == x->parent()->right) {
+				__rb_tree_rotate_left<Augment>(x->parent(), header);
 			}
 			else {
-				__rb_tree_rotate_right(x->parent, header->parent);
+				__rb_tree_rotate_right<Augment>(x->parent(), header);
 			}
 
-			brother->color = __rb_tree_black;
-			x->parent->color = __rb_tree_red;
+			brother->set_color(__rb_tree_black);
+			x->parent()->set_color(__rb_tree_red);
 
 			__erase_node_case2_reblance(x);		//对x重新执行这个过程，此时一定是情形一 二 三中的一种
 		}
@@ -798,115 +1374,122 @@ namespace detail {
 
 
 /* 全局函数：调整树形使其平衡（改变颜色及旋转树形） */
-/* 参数一为新增节点，参数二为 root */
-	inline void __rb_tree_rebalance(__rb_tree_node_base* x, __rb_tree_node_base*& root) {
-		x->color = __rb_tree_red;		//新节点必为红（根据规则4）
+/* 参数一为新增节点，参数二为 header（其父节点即 root） */
+	template<class Augment>
+	inline void __rb_tree_rebalance(__rb_tree_node_base* x, __rb_tree_node_base* header) {
+		x->set_color(__rb_tree_red);		//新节点必为红（根据规则4）
 
-		while (x != root && x->parent->color == __rb_tree_red)	//父节点也为红色
+		while (x != header->parent() && x->parent()->color() == __rb_tree_red)	//父节点也为红色
 		{
-			if (x->parent == x->parent->parent->left)		//父节点为祖父节点的左子节点
+			if (x->parent() == x->parent()->parent()->left)		//父节点为祖父节点的左子节点
 			{
-				__rb_tree_node_base* y = x->parent->parent->right;	//令 y 为伯父节点
+				__rb_tree_node_base* y = x->parent()->parent()->right;	//令 y 为伯父节点
 
-				if (y && y->color == __rb_tree_red)			//伯父节点存在且为红色（对应P211状况4）
+				if (y && y->color() == __rb_tree_red)			//伯父节点存在且为红色（对应P211状况4）
 				{
-					y->color = __rb_tree_black;				//更改伯父节点为黑
-					x->parent->color = __rb_tree_black;		//更改父节点为黑
-					x->parent->parent->color = __rb_tree_red;	//更改祖父节点为红
+					y->set_color(__rb_tree_black);				//更改伯父节点为黑
+					x->parent()->set_color(__rb_tree_black);		//更改父节点为黑
+					x->parent()->parent()->set_color(__rb_tree_red);	//更改祖父节点为红
 
-					x = x->parent->parent;		/* x 上升到祖父节点，下次继续判断祖父节点和太祖父节点是否同时为红 */
+					x = x->parent()->parent();		/* x 上升到祖父节点，下次继续判断祖父节点和太祖父节点是否同时为红 */
 				}
 				else	//无伯父节点，或伯父节点为黑
 				{
-					if (x == x->parent->right)			//如果新节点为父节点的右子节点（对应P210状况2）
+					if (x == x->parent()->right)			//如果新节点为父节点的右子节点（对应P210状况2）
 					{
-						x = x->parent;					//修改 x 为其父节点，先对其父节点进行一次左旋操作
-						__rb_tree_rotate_left(x, root);
+						x = x->parent();					//修改 x 为其父节点，先对其父节点进行一次左旋操作
+						__rb_tree_rotate_left<Augment>(x, header);
 					}
-					x->parent->color = __rb_tree_black;			//将父节点改为黑
-					x->parent->parent->color = __rb_tree_red;	//将祖父节点改为红
-					__rb_tree_rotate_right(x->parent->parent, root);	//对祖父节点执行右旋
+					x->parent()->set_color(__rb_tree_black);			//将父节点改为黑
+					x->parent()->parent()->set_color(__rb_tree_red);	//将祖父节点改为红
+					__rb_tree_rotate_right<Augment>(x->parent()->parent(), header);	//对祖父节点执行右旋
 
 					/* 此时x和兄弟节点(原祖父节点)为红，x父节点为黑，已满足rb_tree要求，下次循环将退出while */
 				}
 			}
 			else		//父节点为祖父节点的右子节点
 			{
-				__rb_tree_node_base* y = x->parent->parent->left;	//令 y 为伯父节点
+				__rb_tree_node_base* y = x->parent()->parent()->left;	//令 y 为伯父节点
 
-				if (y && y->color == __rb_tree_red)		//伯父节点存在且为红色（对应上述状况4的镜像）
+				if (y && y->color() == __rb_tree_red)		//伯父节点存在且为红色（对应上述状况4的镜像）
 				{
-					y->color = __rb_tree_black;				//更改伯父节点为黑
-					x->parent->color = __rb_tree_black;		//更改父节点为黑
-					x->parent->parent->color = __rb_tree_red;	//更改祖父节点为红
+					y->set_color(__rb_tree_black);				//更改伯父节点为黑
+					x->parent()->set_color(__rb_tree_black);		//更改父节点为黑
+					x->parent()->parent()->set_color(__rb_tree_red);	//更改祖父节点为红
 
-					x = x->parent->parent;		/* x 上升到祖父节点，下次继续判断祖父节点和太祖父节点是否同时为红 */
+					x = x->parent()->parent();		/* x 上升到祖父节点，下次继续判断祖父节点和太祖父节点是否同时为红 */
 				}
 				else	///无伯父节点，或伯父节点为黑
 				{
-					if (x == x->parent->left)		//如果新节点为父节点的左子节点（对应上述状况2的镜像）
+					if (x == x->parent()->left)		//如果新节点为父节点的左子节点（对应上述状况2的镜像）
 					{
-						x = x->parent;				//修改 x 为其父节点，先对其父节点进行一次右旋操作
-						__rb_tree_rotate_right(x, root);
+						x = x->parent();				//修改 x 为其父节点，先对其父节点进行一次右旋操作
+						__rb_tree_rotate_right<Augment>(x, header);
 					}
-					x->parent->color = __rb_tree_black;			//将父节点改为黑
-					x->parent->parent->color = __rb_tree_red;	//将祖父节点改为红
-					__rb_tree_rotate_left(x->parent->parent, root);		//对祖父节点执行左旋
+					x->parent()->set_color(__rb_tree_black);			//将父节点改为黑
+					x->parent()->parent()->set_color(__rb_tree_red);	//将祖父节点改为红
+					__rb_tree_rotate_left<Augment>(x->parent()->parent(), header);		//对祖父节点执行左旋
 
 					/* 此时x和兄弟节点(原祖父节点)为红，x父节点为黑，已满足rb_tree要求，下次循环将退出while */
 				}
 			}
 		}		//while 结束
-		root->color = __rb_tree_black;		//根节点永远为黑
+		header->parent()->set_color(__rb_tree_black);		//根节点永远为黑
 	}
 
-/* 全局函数：x为左旋点，root为根节点 */
+/* 全局函数：x为左旋点，header为头节点（其父节点即根节点） */
 /* 新节点必为红节点，如果插入点的父节点也为红节点，则可能需要进行树形旋转及颜色改变 */
-	inline void __rb_tree_rotate_left(__rb_tree_node_base* x, __rb_tree_node_base*& root) {
+	template<class Augment>
+	inline void __rb_tree_rotate_left(__rb_tree_node_base* x, __rb_tree_node_base* header) {
 		__rb_tree_node_base* y = x->right;		//令 y 为左旋点的右子节点
 		x->right = y->left;
 		if (y->left != nullptr) {
-			y->left->parent = x;		//别忘了设定父节点
+			y->left->set_parent(x);		//别忘了设定父节点
 		}
-		y->parent = x->parent;
+		y->set_parent(x->parent());
 
 		//令 y 完全顶替 x 的地位（必须将 x 对其父节点的关系完全接收过来）
-		if (x == root) {					//如果 x 为根节点，将 y 设为新的根节点
-			root = y;
-			x->parent->parent = y;			//令header的parent指向新的根节点
+		if (x == header->parent()) {		//如果 x 为根节点，将 y 设为新的根节点
+			header->set_parent(y);			//令header的parent指向新的根节点
 		}
-		else if (x == x->parent->left)		//x 为其父节点的左子节点
-			x->parent->left = y;
+		else if (x == x->parent()->left)		//x 为其父节点的左子节点
+			x->parent()->left = y;
 		else								//x 为其父节点的右子节点
-			x->parent->right = y;
+			x->parent()->right = y;
 		y->left = x;
-		x->parent = y;
+		x->set_parent(y);
+
+		Augment::update(x);		//x 成为 y 的子节点，先更新 x 再更新 y
+		Augment::update(y);
 	}
 
-/* 全局函数：x为右旋点，root为根节点 */
+/* 全局函数：x为右旋点，header为头节点（其父节点即根节点） */
 /* 新节点必为红节点，如果插入点的父节点也为红节点，则可能需要进行树形旋转及颜色改变 */
-	inline void __rb_tree_rotate_right(__rb_tree_node_base* x, __rb_tree_node_base*& root) {
+	template<class Augment>
+	inline void __rb_tree_rotate_right(__rb_tree_node_base* x, __rb_tree_node_base* header) {
 		__rb_tree_node_base* y = x->left;		//令 y 为右旋点的左子节点
 		x->left = y->right;
 		if (y->right != nullptr) {
-			y->right->parent = x;		//别忘了设定父节点
+			y->right->set_parent(x);		//别忘了设定父节点
 		}
-		y->parent = x->parent;
+		y->set_parent(x->parent());
 
 		//令 y 完全顶替 x 的地位（必须将 x 对其父节点的关系完全接收过来）
-		if (x == root) {					//如果 x 为根节点，将 y 设为新的根节点
-			root = y;
-			x->parent->parent = y;			//令header的parent指向新的根节点
+		if (x == header->parent()) {		//如果 x 为根节点，将 y 设为新的根节点
+			header->set_parent(y);			//令header的parent指向新的根节点
 		}
-		else if (x == x->parent->right)		//x 为其父节点的右子节点
-			x->parent->right = y;
+		else if (x == x->parent()->right)		//x 为其父节点的右子节点
+			x->parent()->right = y;
 		else								//x 为其父节点的左子节点
-			x->parent->left = y;
+			x->parent()->left = y;
 		y->right = x;
-		x->parent = y;
+		x->set_parent(y);
+
+		Augment::update(x);
+		Augment::update(y);
 	}
 
 } // end of namespace detail
 } // end of namespace lfp
 
-#endif	//!_STL_RB_TREE_H_
\ No newline at end of file
+#endif	//!_STL_RB_TREE_H_
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "1stl_alloctor.h"
 #include "2stl_algobase.h"		//identity less
 #include "11stl_rbtree.h"
+#include <utility>			//forward
 
 namespace lfp {
 
@@ -47,6 +48,11 @@ namespace lfp {
 		set(InputIterator first, InputIterator last) : t(Compare()) {
 			t.insert_unique(first, last);
 		}
+		//[first, last) 已按键值严格递增排序，线性时间建立
+		template<class ForwardIterator>
+		set(sorted_unique_t, ForwardIterator first, ForwardIterator last) : t(Compare()) {
+			t.assign_sorted(first, last);
+		}
 		set(const set<Key, Compare, Alloc>& x) : t(x.t) { }
 
 		set<Key, Compare, Alloc>& operator=(const set<Key, Compare, Alloc>& x) {
@@ -73,9 +79,19 @@ namespace lfp {
 			std::pair<rep_iterator, bool> p = t.insert_unique(x);
 			return std::pair<iterator, bool>(p.first, p.second);
 		}
-		/*iterator insert(iterator pos, const value_type& x) {
+		//pos 为提示：新元素应紧邻 pos 之前，例如按键值递增的顺序以 end() 为提示插入，均摊常数时间
+		iterator insert(const_iterator pos, const value_type& x) {
 			return t.insert_unique(pos, x);
-		}*/
+		}
+		template<class... Args>
+		std::pair<iterator, bool> emplace(Args&&... args) {
+			std::pair<rep_iterator, bool> p = t.emplace_unique(std::forward<Args>(args)...);
+			return std::pair<iterator, bool>(p.first, p.second);
+		}
+		template<class... Args>
+		iterator emplace_hint(const_iterator pos, Args&&... args) {
+			return t.emplace_hint_unique(pos, std::forward<Args>(args)...);
+		}
 		template<class InputIterator>
 		void insert(InputIterator first, InputIterator last) {
 			t.insert_unique(first, last);
@@ -83,13 +99,13 @@ namespace lfp {
 
 		//erase
 		void erase(iterator pos) {
-			t.erase((rep_iterator&)pos);
+			t.erase(pos);
 		}
 		size_type erase(const key_type& x) {
 			return t.erase(x);
 		}
 		void erase(iterator first, iterator last) {
-			t.erase((rep_iterator&)first, (rep_iterator&)last);
+			t.erase(first, last);
 		}
 		void clear() { t.clear(); }
 
@@ -102,6 +118,15 @@ namespace lfp {
 		/* 返回元素 x 的区间 */
 		std::pair<iterator, iterator> equal_range(const key_type& x) const { return t.equal_range(x); }
 
+#ifdef __STL_RB_TREE_ORDER_STATISTICS
+		/* 以下需要定义 __STL_RB_TREE_ORDER_STATISTICS，时间复杂度 O(log n) */
+		//第 k 个元素（从0开始计），k >= size() 时传回 end()
+		iterator nth(size_type k) const { return t.nth(k); }
+		//键值小于 x 的元素个数
+		size_type rank(const key_type& x) const { return t.rank(x); }
+		difference_type distance(iterator first, iterator last) const { return t.distance(first, last); }
+#endif
+
 //		friend bool operator==(const set& x, const set& y);
 //		friend bool operator< (const set& x, const set& y);
 	};
@@ -10,6 +10,7 @@
 #include "1stl_alloctor.h"
 #include "2stl_algobase.h"		//identity less
 #include "11stl_rbtree.h"
+#include <utility>			//forward
 
 namespace lfp {
 
@@ -46,6 +47,11 @@ namespace lfp {
 		multiset(InputIterator first, InputIterator last) : t(Compare()) {
 			t.insert_equal(first, last);
 		}
+		//[first, last) 已按键值非递减排序，线性时间建立
+		template<class ForwardIterator>
+		multiset(sorted_equivalent_t, ForwardIterator first, ForwardIterator last) : t(Compare()) {
+			t.assign_sorted(first, last);
+		}
 		multiset(const multiset<Key, Compare, Alloc>& x) : t(x.t) { }
 
 		multiset<Key, Compare, Alloc>& operator=(const multiset<Key, Compare, Alloc>& x) {
@@ -68,13 +74,21 @@ namespace lfp {
 		void swap(multiset<Key, Compare, Alloc>& x) { t.swap(x.t); }
 
 		//insert
-		std::pair<iterator, bool> insert(const value_type& x) {
-			std::pair<rep_iterator, bool> p = t.insert_equal(x);
-			return std::pair<iterator, bool>(p.first, p.second);
+		iterator insert(const value_type& x) {
+			return t.insert_equal(x);
 		}
-		/*iterator insert(iterator pos, const value_type& x) {
+		//pos 为提示：新元素应紧邻 pos 之前，例如按键值递增的顺序以 end() 为提示插入，均摊常数时间
+		iterator insert(const_iterator pos, const value_type& x) {
 			return t.insert_equal(pos, x);
-		}*/
+		}
+		template<class... Args>
+		iterator emplace(Args&&... args) {
+			return t.emplace_equal(std::forward<Args>(args)...);
+		}
+		template<class... Args>
+		iterator emplace_hint(const_iterator pos, Args&&... args) {
+			return t.emplace_hint_equal(pos, std::forward<Args>(args)...);
+		}
 		template<class InputIterator>
 		void insert(InputIterator first, InputIterator last) {
 			t.insert_equal(first, last);
@@ -82,13 +96,13 @@ namespace lfp {
 
 		//erase
 		void erase(iterator pos) {
-			t.erase((rep_iterator&)pos);
+			t.erase(pos);
 		}
 		size_type erase(const key_type& x) {
 			return t.erase(x);
 		}
 		void erase(iterator first, iterator last) {
-			t.erase((rep_iterator&)first, (rep_iterator&)last);
+			t.erase(first, last);
 		}
 		void clear() { t.clear(); }
 
@@ -101,6 +115,15 @@ namespace lfp {
 		/* 返回元素 x 的区间 */
 		std::pair<iterator, iterator> equal_range(const key_type& x) const { return t.equal_range(x); }
 
+#ifdef __STL_RB_TREE_ORDER_STATISTICS
+		/* 以下需要定义 __STL_RB_TREE_ORDER_STATISTICS，时间复杂度 O(log n) */
+		//第 k 个元素（从0开始计），k >= size() 时传回 end()
+		iterator nth(size_type k) const { return t.nth(k); }
+		//键值小于 x 的元素个数
+		size_type rank(const key_type& x) const { return t.rank(x); }
+		difference_type distance(iterator first, iterator last) const { return t.distance(first, last); }
+#endif
+
 //		friend bool operator==(const multiset& x, const multiset& y);
 //		friend bool operator< (const multiset& x, const multiset& y);
 	};
@@ -13,7 +13,7 @@
 #include "1stl_alloctor.h"
 #include "2stl_algobase.h"	//select1st less
 #include "11stl_rbtree.h"
-#include <utility>			//pair
+#include <utility>			//pair forward
 
 namespace lfp {
 
@@ -63,6 +63,11 @@ namespace lfp {
 		map(InputIterator first, InputIterator last) : t(Compare()) {
 			t.insert_unique(first, last);
 		}
+		//[first, last) 已按键值严格递增排序，线性时间建立
+		template<class ForwardIterator>
+		map(sorted_unique_t, ForwardIterator first, ForwardIterator last) : t(Compare()) {
+			t.assign_sorted(first, last);
+		}
 		map(const map<Key, T, Compare, Alloc>& x) : t(x.t) { }
 
 		map<Key, T, Compare, Alloc>& operator=(const map<Key, T, Compare, Alloc>& x) {
@@ -98,16 +103,25 @@ namespace lfp {
 		std::pair<iterator, bool> insert(const value_type& x) {
 			return t.insert_unique(x);
 		}
-		/*iterator insert(iterator pos, const value_type& x) {
+		//pos 为提示：新元素应紧邻 pos 之前，例如按键值递增的顺序以 end() 为提示插入，均摊常数时间
+		iterator insert(const_iterator pos, const value_type& x) {
 			return t.insert_unique(pos, x);
-		}*/
+		}
+		template<class... Args>
+		std::pair<iterator, bool> emplace(Args&&... args) {
+			return t.emplace_unique(std::forward<Args>(args)...);
+		}
+		template<class... Args>
+		iterator emplace_hint(const_iterator pos, Args&&... args) {
+			return t.emplace_hint_unique(pos, std::forward<Args>(args)...);
+		}
 		template<class InputIterator>
 		void insert(InputIterator first, InputIterator last) {
 			t.insert_unique(first, last);
 		}
 	
 		void erase(iterator pos) { t.erase(pos); }
-		void erase(const key_type& x) { t.erase(x); }
+		size_type erase(const key_type& x) { return t.erase(x); }
 		void erase(iterator first, iterator last) { t.erase(first, last); }
 		void clear() { t.clear(); }
 
@@ -128,6 +142,19 @@ namespace lfp {
 		std::pair<iterator, iterator> equal_range(const key_type& x) {
 			return t.equal_range(x);
 		}
+		std::pair<const_iterator, const_iterator> equal_range(const key_type& x) const {
+			return t.equal_range(x);
+		}
+
+#ifdef __STL_RB_TREE_ORDER_STATISTICS
+		/* 以下需要定义 __STL_RB_TREE_ORDER_STATISTICS，时间复杂度 O(log n) */
+		//第 k 个元素（从0开始计），k >= size() 时传回 end()
+		iterator nth(size_type k) { return t.nth(k); }
+		const_iterator nth(size_type k) const { return t.nth(k); }
+		//键值小于 x 的元素个数
+		size_type rank(const key_type& x) const { return t.rank(x); }
+		difference_type distance(const_iterator first, const_iterator last) const { return t.distance(first, last); }
+#endif
 
 //		friend bool operator==(const map&, const map&);
 //		friend bool operator< (const map&, const map&);
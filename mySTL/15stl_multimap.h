@@ -10,7 +10,7 @@
 #include "1stl_alloctor.h"
 #include "2stl_algobase.h"	//select1st less
 #include "11stl_rbtree.h"
-#include <utility>			//pair
+#include <utility>			//pair forward
 
 namespace lfp {
 
@@ -60,6 +60,11 @@ namespace lfp {
 		multimap(InputIterator first, InputIterator last) : t(Compare()) {
 			t.insert_equal(first, last);
 		}
+		//[first, last) 已按键值非递减排序，线性时间建立
+		template<class ForwardIterator>
+		multimap(sorted_equivalent_t, ForwardIterator first, ForwardIterator last) : t(Compare()) {
+			t.assign_sorted(first, last);
+		}
 		multimap(const multimap<Key, T, Compare, Alloc>& x) : t(x.t) { }
 
 		multimap<Key, T, Compare, Alloc>& operator=(const multimap<Key, T, Compare, Alloc>& x) {
@@ -95,16 +100,25 @@ namespace lfp {
 		iterator insert(const value_type& x) {
 			return t.insert_equal(x);
 		}
-		/*iterator insert(iterator pos, const value_type& x) {
+		//pos 为提示：新元素应紧邻 pos 之前，例如按键值递增的顺序以 end() 为提示插入，均摊常数时间
+		iterator insert(const_iterator pos, const value_type& x) {
 			return t.insert_equal(pos, x);
-		}*/
+		}
+		template<class... Args>
+		iterator emplace(Args&&... args) {
+			return t.emplace_equal(std::forward<Args>(args)...);
+		}
+		template<class... Args>
+		iterator emplace_hint(const_iterator pos, Args&&... args) {
+			return t.emplace_hint_equal(pos, std::forward<Args>(args)...);
+		}
 		template<class InputIterator>
 		void insert(InputIterator first, InputIterator last) {
 			t.insert_equal(first, last);
 		}
 	
 		void erase(iterator pos) { t.erase(pos); }
-		void erase(const key_type& x) { t.erase(x); }
+		size_type erase(const key_type& x) { return t.erase(x); }
 		void erase(iterator first, iterator last) { t.erase(first, last); }
 		void clear() { t.clear(); }
 
@@ -125,6 +139,19 @@ namespace lfp {
 		std::pair<iterator, iterator> equal_range(const key_type& x) {
 			return t.equal_range(x);
 		}
+		std::pair<const_iterator, const_iterator> equal_range(const key_type& x) const {
+			return t.equal_range(x);
+		}
+
+#ifdef __STL_RB_TREE_ORDER_STATISTICS
+		/* 以下需要定义 __STL_RB_TREE_ORDER_STATISTICS，时间复杂度 O(log n) */
+		//第 k 个元素（从0开始计），k >= size() 时传回 end()
+		iterator nth(size_type k) { return t.nth(k); }
+		const_iterator nth(size_type k) const { return t.nth(k); }
+		//键值小于 x 的元素个数
+		size_type rank(const key_type& x) const { return t.rank(x); }
+		difference_type distance(const_iterator first, const_iterator last) const { return t.distance(first, last); }
+#endif
 
 //		friend bool operator==(const multimap&, const multimap&);
 //		friend bool operator< (const multimap&, const multimap&);
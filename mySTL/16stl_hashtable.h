@@ -10,6 +10,7 @@
 #include "1stl_alloctor.h"
 #include "2stl_algobase.h"	//select1st less
 #include "4stl_vector.h"
+#include "23stl_hash_fun.h"	//hash
 #include <utility>			//pair
 
 
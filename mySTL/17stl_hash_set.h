@@ -21,7 +21,7 @@ namespace lfp {
 	 *	Alloc:		内存分配器
 	 */
 	template<class Value,
-			 class HashFunc = std::hash<Value>,
+			 class HashFunc = hash<Value>,
 			 class EqualKey = equal_to<Value>,
 			 class Alloc = alloc>
 	struct hash_set {
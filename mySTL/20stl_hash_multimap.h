@@ -14,7 +14,7 @@
 
 namespace lfp {
 
-	template<class Key, class T, class HashFunc = std::hash<Key>,
+	template<class Key, class T, class HashFunc = hash<Key>,
 			 class EqualKey = equal_to<Key>, class Alloc = alloc>
 	struct hash_multimap {
 	private:
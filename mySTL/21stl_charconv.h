@@ -0,0 +1,695 @@
+/*
+ *from_chars实现：与区域设置(locale)无关的数值解析
+ *
+ *直接在 [first, last) 字符区间上解析整数和浮点数，不要求以'\0'结尾，不拷贝，不抛出异常，
+ *错误通过返回值 from_chars_result 的 ec 成员报告，语义与 C++17 的 std::from_chars 保持一致：
+ *	·不接受前导空白和 '+' 号，无符号型别不接受 '-' 号
+ *	·没有可解析的数字时 ec 为 errc::invalid_argument，ptr 等于 first，value 不被修改
+ *	·数值超出型别范围时 ec 为 errc::result_out_of_range，ptr 指向数字之后，value 不被修改；
+ *	 非0的浮点数舍入为0（下溢）时同样如此
+ *
+ *整数的十进制解析使用 SWAR(SIMD within a register) 技巧，一次判断并转换 8 个字符；
+ *浮点数先尝试 Clinger 快速路径（尾数不超过 2^53 且 10 的幂次可精确表示时，一次乘除即可得到
+ *正确舍入的结果），否则退回到十进制大数移位算法，结果总是正确舍入的，全程不调用 strtod
+ */
+
+#ifndef _STL_CHARCONV_H_
+#define _STL_CHARCONV_H_
+
+#include "3stl_string.h"
+#include <float.h>			//for FLT_EVAL_METHOD
+#include <limits>			//for numeric_limits
+#include <system_error>		//for errc
+#include <stdint.h>			//for uint64_t
+#include <string.h>			//for memcpy
+
+namespace lfp {
+
+	/* from_chars 的返回值：ptr 指向第一个未被解析的字符，ec 为错误码（成功时为 errc()） */
+	struct from_chars_result {
+		const char* ptr;
+		std::errc ec;
+	};
+
+namespace detail {
+
+	inline bool __is_digit(char c) {
+		return (unsigned char)(c - '0') < 10;
+	}
+
+	//将字符转换为 base 进制下的数值，非法字符返回一个不小于 36 的值
+	inline unsigned __char_to_digit(char c) {
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		if (c >= 'a' && c <= 'z')
+			return c - 'a' + 10;
+		if (c >= 'A' && c <= 'Z')
+			return c - 'A' + 10;
+		return 36;
+	}
+
+/* 以下为 SWAR 工具函数，一次处理 8 个字符 */
+	//以小端序读取 8 个字节，大端机器上需要翻转字节序
+	inline uint64_t __read_eight_bytes(const char* p) {
+		uint64_t val;
+		memcpy(&val, p, sizeof(uint64_t));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		val = __builtin_bswap64(val);
+#endif
+		return val;
+	}
+
+	//判断 8 个字节是否全部为 '0'~'9'：任何一个字节小于 0x30 或大于 0x39 都会使其最高位置 1
+	inline bool __is_eight_digits(uint64_t val) {
+		return !(((val + 0x4646464646464646ull) | (val - 0x3030303030303030ull)) & 0x8080808080808080ull);
+	}
+
+	//将 8 个数字字符转换为数值，只需要三次乘法（相邻两位、四位、八位依次合并）
+	inline uint32_t __parse_eight_digits(uint64_t val) {
+		const uint64_t mask = 0x000000FF000000FFull;
+		const uint64_t mul1 = 0x000F424000000064ull;	// 100 + (1000000 << 32)
+		const uint64_t mul2 = 0x0000271000000001ull;	// 1 + (10000 << 32)
+		val -= 0x3030303030303030ull;
+		val = (val * 10) + (val >> 8);		//相邻两位合并为 0~99
+		val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+		return uint32_t(val);
+	}
+
+	//返回 [first, last) 起始处连续数字字符的结尾
+	inline const char* __skip_digits(const char* first, const char* last) {
+		while (last - first >= 8 && __is_eight_digits(__read_eight_bytes(first)))
+			first += 8;
+		while (first != last && __is_digit(*first))
+			++first;
+		return first;
+	}
+
+	//将 [first, last) 内不超过 19 个的数字字符转换为数值，调用者保证不会溢出
+	inline uint64_t __digits_to_uint64(const char* first, const char* last) {
+		uint64_t val = 0;
+		while (last - first >= 8) {
+			val = val * 100000000ull + __parse_eight_digits(__read_eight_bytes(first));
+			first += 8;
+		}
+		for (; first != last; ++first)
+			val = val * 10 + (*first - '0');
+		return val;
+	}
+
+
+/* 整数解析 */
+	//十进制版本：先找到数字串的结尾，再按 8 位一组转换，溢出与否只需比较有效数字位数
+	inline from_chars_result __from_chars_uint64_dec(const char* first, const char* last, uint64_t& value) {
+		from_chars_result res = { first, std::errc() };
+		const char* digits_end = __skip_digits(first, last);
+		if (digits_end == first) {
+			res.ec = std::errc::invalid_argument;
+			return res;
+		}
+		res.ptr = digits_end;
+
+		while (first != digits_end && *first == '0')	//前导0不影响数值
+			++first;
+		ptrdiff_t n = digits_end - first;		//有效数字位数
+		if (n <= 19) {		//19位十进制数一定不超过 uint64_t 的范围
+			value = __digits_to_uint64(first, digits_end);
+		}
+		else if (n == 20) {
+			uint64_t high = __digits_to_uint64(first, digits_end - 1);
+			unsigned low = digits_end[-1] - '0';
+			if (high > (std::numeric_limits<uint64_t>::max() - low) / 10)
+				res.ec = std::errc::result_out_of_range;
+			else
+				value = high * 10 + low;
+		}
+		else {
+			res.ec = std::errc::result_out_of_range;
+		}
+		return res;
+	}
+
+	//任意进制版本(2~36)，逐个字符处理并检查溢出
+	inline from_chars_result __from_chars_uint64(const char* first, const char* last, uint64_t& value, int base) {
+		if (base == 10)
+			return __from_chars_uint64_dec(first, last, value);
+
+		from_chars_result res = { first, std::errc() };
+		const uint64_t max_val = std::numeric_limits<uint64_t>::max();
+		uint64_t val = 0;
+		bool overflow = false;
+		const char* p = first;
+		for (; p != last; ++p) {
+			unsigned digit = __char_to_digit(*p);
+			if (digit >= (unsigned)base)
+				break;
+			if (!overflow) {
+				if (val > (max_val - digit) / base)
+					overflow = true;
+				else
+					val = val * base + digit;
+			}
+		}
+
+		if (p == first) {
+			res.ec = std::errc::invalid_argument;
+			return res;
+		}
+		res.ptr = p;
+		if (overflow)
+			res.ec = std::errc::result_out_of_range;
+		else
+			value = val;
+		return res;
+	}
+
+	//所有整数型别的公共实现：先按 uint64_t 解析，再根据目标型别检查范围
+	template<class Integer>
+	from_chars_result __from_chars_integer(const char* first, const char* last, Integer& value, int base) {
+		from_chars_result res = { first, std::errc() };
+		bool negative = false;
+		if (std::numeric_limits<Integer>::is_signed && first != last && *first == '-') {
+			negative = true;
+			++first;
+		}
+
+		uint64_t val = 0;
+		res = __from_chars_uint64(first, last, val, base);
+		if (res.ec == std::errc::invalid_argument) {
+			res.ptr = first - negative;		//'-'之后没有数字时，ptr 指向最初的 first
+			return res;
+		}
+		if (res.ec != std::errc())
+			return res;
+
+		const uint64_t max_val = (uint64_t)std::numeric_limits<Integer>::max();
+		if (negative) {
+			if (val > max_val + 1) {
+				res.ec = std::errc::result_out_of_range;
+				return res;
+			}
+			//val - 1 一定可以用 Integer 表示，这样写不会溢出
+			value = (val == 0) ? Integer(0) : Integer(-Integer(val - 1) - 1);
+		}
+		else {
+			if (val > max_val) {
+				res.ec = std::errc::result_out_of_range;
+				return res;
+			}
+			value = Integer(val);
+		}
+		return res;
+	}
+
+
+/* 浮点数解析 */
+	//描述 IEEE-754 浮点型别的位布局
+	struct __float_info {
+		unsigned mantbits;		//尾数位数（不含隐藏位）
+		unsigned expbits;		//指数位数
+		int bias;				//指数偏移
+	};
+
+	/* 十进制大数，用于浮点数的慢速路径。数值为 0.d[0]d[1]...d[nd-1] * 10^dp */
+	/* 通过对十进制数字串做二进制的左右移位，把数值规约到 [1/2, 1) 后取出尾数，因此结果总是正确舍入 */
+	struct __decimal {
+		enum { max_digits = 800 };		//double 正确舍入最多需要 767 位有效数字
+		enum { max_shift = 60 };		//单次移位的最大位数，保证中间结果不超出 uint64_t
+
+		char d[max_digits];		//十进制数字（'0'~'9'）
+		int nd;					//有效数字位数
+		int dp;					//小数点位置
+		bool negative;
+		bool truncated;			//是否有非0数字因超出 max_digits 被丢弃
+
+		//去掉末尾的0
+		void trim() {
+			while (nd > 0 && d[nd - 1] == '0')
+				--nd;
+			if (nd == 0)
+				dp = 0;
+		}
+
+		//乘以 2^k：从低位向高位逐位相乘并进位
+		void left_shift(unsigned k) {
+			//乘以 2^k 后新增的位数为 floor(k*log10(2)) 或再多一位，先按多一位写入，最后再修正
+			int delta = int((k * 1233) >> 12) + 1;
+			int r = nd;
+			int w = nd + delta;
+			uint64_t n = 0;
+
+			for (--r; r >= 0; --r) {
+				n += uint64_t(d[r] - '0') << k;
+				uint64_t quo = n / 10;
+				uint64_t rem = n - 10 * quo;
+				--w;
+				if (w < max_digits)
+					d[w] = char('0' + rem);
+				else if (rem != 0)
+					truncated = true;
+				n = quo;
+			}
+			while (n > 0) {
+				uint64_t quo = n / 10;
+				uint64_t rem = n - 10 * quo;
+				--w;
+				if (w < max_digits)
+					d[w] = char('0' + rem);
+				else if (rem != 0)
+					truncated = true;
+				n = quo;
+			}
+
+			//w 为多预留的位数（0 或 1），将数字整体前移
+			nd += delta;
+			if (w > 0) {
+				memmove(d, d + w, (nd > max_digits ? max_digits : nd) - w);
+				nd -= w;
+				delta -= w;
+			}
+			if (nd > max_digits)
+				nd = max_digits;
+			dp += delta;
+			trim();
+		}
+
+		//除以 2^k：从高位向低位逐位相除
+		void right_shift(unsigned k) {
+			int r = 0;
+			int w = 0;
+			uint64_t n = 0;
+
+			//先读入足够多的位，使 n >= 2^k
+			for (; (n >> k) == 0; ++r) {
+				if (r >= nd) {
+					if (n == 0) {
+						nd = 0;
+						return;
+					}
+					while ((n >> k) == 0) {
+						n = n * 10;
+						++r;
+					}
+					break;
+				}
+				n = n * 10 + (d[r] - '0');
+			}
+			dp -= r - 1;
+
+			const uint64_t mask = (uint64_t(1) << k) - 1;
+			for (; r < nd; ++r) {
+				uint64_t dig = n >> k;
+				n &= mask;
+				d[w++] = char('0' + dig);
+				n = n * 10 + (d[r] - '0');
+			}
+			while (n > 0) {
+				uint64_t dig = n >> k;
+				n &= mask;
+				if (w < max_digits)
+					d[w++] = char('0' + dig);
+				else if (dig > 0)
+					truncated = true;
+				n = n * 10;
+			}
+			nd = w;
+			trim();
+		}
+
+		//k > 0 左移，k < 0 右移
+		void shift(int k) {
+			if (nd == 0)
+				return;
+			if (k > 0) {
+				while (k > max_shift) {
+					left_shift(max_shift);
+					k -= max_shift;
+				}
+				left_shift(k);
+			}
+			else if (k < 0) {
+				while (k < -max_shift) {
+					right_shift(max_shift);
+					k += max_shift;
+				}
+				right_shift(-k);
+			}
+		}
+
+		//判断截断到 n 位时是否应当进位（恰好一半时舍入到偶数）
+		bool should_round_up(int n) const {
+			if (n < 0 || n >= nd)
+				return false;
+			if (d[n] == '5' && n + 1 == nd) {
+				if (truncated)
+					return true;
+				return n > 0 && (d[n - 1] - '0') % 2 == 1;
+			}
+			return d[n] >= '5';
+		}
+
+		//返回四舍五入后的整数部分
+		uint64_t rounded_integer() const {
+			if (dp > 20)
+				return std::numeric_limits<uint64_t>::max();
+			int i = 0;
+			uint64_t n = 0;
+			for (; i < dp && i < nd; ++i)
+				n = n * 10 + (d[i] - '0');
+			for (; i < dp; ++i)
+				n *= 10;
+			if (should_round_up(dp))
+				++n;
+			return n;
+		}
+
+		//转换为浮点数的位表示，溢出时 overflow 为 true，结果为无穷大
+		uint64_t float_bits(const __float_info& flt, bool& overflow) {
+			//每次移位使 dp 减少到 0 所需的位数
+			static const int powtab[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+			const int powtab_size = sizeof(powtab) / sizeof(powtab[0]);
+			const int max_exp = (1 << flt.expbits) - 1;
+			int exp = 0;
+			uint64_t mant = 0;
+			overflow = false;
+
+			if (nd == 0 || dp < -330) {		//0 或下溢
+				exp = flt.bias;
+			}
+			else if (dp > 310) {			//上溢
+				overflow = true;
+			}
+			else {
+				//将数值规约到 [1/2, 1)
+				while (dp > 0) {
+					int n = (dp >= powtab_size) ? 27 : powtab[dp];
+					shift(-n);
+					exp += n;
+				}
+				while (dp < 0 || (dp == 0 && d[0] < '5')) {
+					int n = (-dp >= powtab_size) ? 27 : powtab[-dp];
+					shift(n);
+					exp -= n;
+				}
+				--exp;		//浮点数的尾数范围为 [1, 2)
+
+				//指数过小时产生非规格化数
+				if (exp < flt.bias + 1) {
+					int n = flt.bias + 1 - exp;
+					shift(-n);
+					exp += n;
+				}
+
+				if (exp - flt.bias >= max_exp) {
+					overflow = true;
+				}
+				else {
+					//取出 mantbits+1 位尾数
+					shift(int(1 + flt.mantbits));
+					mant = rounded_integer();
+
+					//舍入导致进位
+					if (mant == (uint64_t(2) << flt.mantbits)) {
+						mant >>= 1;
+						++exp;
+						if (exp - flt.bias >= max_exp)
+							overflow = true;
+					}
+					if ((mant & (uint64_t(1) << flt.mantbits)) == 0)		//非规格化数
+						exp = flt.bias;
+				}
+			}
+
+			if (overflow) {
+				mant = 0;
+				exp = max_exp + flt.bias;
+			}
+			uint64_t bits = mant & ((uint64_t(1) << flt.mantbits) - 1);
+			bits |= uint64_t((exp - flt.bias) & max_exp) << flt.mantbits;
+			if (negative)
+				bits |= uint64_t(1) << (flt.mantbits + flt.expbits);
+			return bits;
+		}
+	};
+
+	//不区分大小写地比较前缀，s 为小写字母串
+	inline bool __match_prefix_nocase(const char* first, const char* last, const char* s) {
+		for (; *s != '\0'; ++s, ++first) {
+			if (first == last || (*first | 0x20) != *s)
+				return false;
+		}
+		return true;
+	}
+
+	/* 以下为浮点数的语法解析结果 */
+	struct __parsed_number {
+		uint64_t mantissa;		//前 19 位有效数字组成的整数
+		int64_t exponent;		//十进制指数，数值为 mantissa * 10^exponent
+		bool negative;
+		bool too_many_digits;	//有效数字超过 19 位，mantissa 不精确
+		const char* int_first;	//整数部分
+		const char* int_last;
+		const char* frac_first;	//小数部分
+		const char* frac_last;
+		int64_t exp_number;		//显式给出的指数
+	};
+
+	//解析 [-]digits[.digits][(e|E)[+|-]digits]，失败时返回 false
+	inline bool __parse_number(const char* first, const char* last, __parsed_number& num, const char*& end) {
+		num.negative = false;
+		num.too_many_digits = false;
+		num.exp_number = 0;
+		if (first != last && *first == '-') {
+			num.negative = true;
+			++first;
+		}
+
+		num.int_first = first;
+		num.int_last = __skip_digits(first, last);
+		const char* p = num.int_last;
+		num.frac_first = num.frac_last = p;
+		if (p != last && *p == '.') {
+			num.frac_first = p + 1;
+			num.frac_last = __skip_digits(p + 1, last);
+			p = num.frac_last;
+		}
+		if (num.int_first == num.int_last && num.frac_first == num.frac_last)
+			return false;		//至少需要一个数字
+
+		//指数部分不完整时（如 "1e" "1e+"）忽略它，与 std::from_chars 一致
+		if (p != last && (*p == 'e' || *p == 'E')) {
+			const char* q = p + 1;
+			bool exp_negative = false;
+			if (q != last && (*q == '-' || *q == '+')) {
+				exp_negative = (*q == '-');
+				++q;
+			}
+			if (q != last && __is_digit(*q)) {
+				int64_t e = 0;
+				for (; q != last && __is_digit(*q); ++q) {
+					if (e < 0x10000000)		//指数过大时已经足以上溢或下溢，不再累加
+						e = e * 10 + (*q - '0');
+				}
+				num.exp_number = exp_negative ? -e : e;
+				p = q;
+			}
+		}
+		end = p;
+
+		//跳过前导0后，取至多 19 位有效数字组成 mantissa
+		const char* ip = num.int_first;
+		while (ip != num.int_last && *ip == '0')
+			++ip;
+		const char* fp = num.frac_first;
+		int64_t exp10 = num.exp_number;
+		if (ip == num.int_last) {
+			while (fp != num.frac_last && *fp == '0') {
+				++fp;
+				--exp10;		//小数部分的前导0
+			}
+		}
+
+		uint64_t mant = 0;
+		int digits = 0;
+		for (; ip != num.int_last; ++ip) {
+			if (digits < 19) {
+				mant = mant * 10 + (*ip - '0');
+				++digits;
+			}
+			else {
+				++exp10;		//整数部分被舍弃的数字
+				if (*ip != '0')
+					num.too_many_digits = true;
+			}
+		}
+		for (; fp != num.frac_last; ++fp) {
+			if (digits < 19) {
+				mant = mant * 10 + (*fp - '0');
+				++digits;
+				--exp10;
+			}
+			else if (*fp != '0') {
+				num.too_many_digits = true;
+			}
+		}
+		num.mantissa = mant;
+		num.exponent = exp10;
+		return true;
+	}
+
+	//用完整的数字串构造十进制大数
+	inline void __init_decimal(__decimal& dec, const __parsed_number& num) {
+		dec.nd = 0;
+		dec.dp = 0;
+		dec.negative = num.negative;
+		dec.truncated = false;
+		bool seen_nonzero = false;
+
+		for (const char* p = num.int_first; p != num.int_last; ++p) {
+			if (*p == '0' && !seen_nonzero)
+				continue;
+			seen_nonzero = true;
+			if (dec.nd < __decimal::max_digits)
+				dec.d[dec.nd++] = *p;
+			else if (*p != '0')
+				dec.truncated = true;
+			++dec.dp;
+		}
+		for (const char* p = num.frac_first; p != num.frac_last; ++p) {
+			if (*p == '0' && !seen_nonzero) {
+				--dec.dp;
+				continue;
+			}
+			seen_nonzero = true;
+			if (dec.nd < __decimal::max_digits)
+				dec.d[dec.nd++] = *p;
+			else if (*p != '0')
+				dec.truncated = true;
+		}
+
+		int64_t dp = dec.dp + num.exp_number;
+		if (dp > 100000)
+			dp = 100000;
+		else if (dp < -100000)
+			dp = -100000;
+		dec.dp = int(dp);
+		dec.trim();
+	}
+
+	//Clinger 快速路径：尾数和 10 的幂次都能被精确表示时，一次乘除即可得到正确舍入的结果
+	template<class Float>
+	bool __fast_path(const __parsed_number& num, Float& value) {
+		static const double pow10[] = {
+			1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+		const int max_exp10 = (std::numeric_limits<Float>::digits > 24) ? 22 : 10;
+		const uint64_t max_mantissa = uint64_t(1) << std::numeric_limits<Float>::digits;
+
+		if (num.too_many_digits || num.mantissa > max_mantissa ||
+			num.exponent < -max_exp10 || num.exponent > max_exp10)
+			return false;
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+		return false;		//x87 等扩展精度求值会产生二次舍入
+#else
+		Float v = Float(num.mantissa);
+		if (num.exponent < 0)
+			v = v / Float(pow10[-num.exponent]);
+		else
+			v = v * Float(pow10[num.exponent]);
+		value = num.negative ? -v : v;
+		return true;
+#endif
+	}
+
+	template<class Float, class UInt>
+	from_chars_result __from_chars_float(const char* first, const char* last, Float& value, const __float_info& flt) {
+		from_chars_result res = { first, std::errc() };
+
+		//inf infinity nan
+		const char* p = first;
+		bool negative = false;
+		if (p != last && *p == '-') {
+			negative = true;
+			++p;
+		}
+		if (__match_prefix_nocase(p, last, "inf")) {
+			res.ptr = __match_prefix_nocase(p, last, "infinity") ? p + 8 : p + 3;
+			value = negative ? -std::numeric_limits<Float>::infinity() : std::numeric_limits<Float>::infinity();
+			return res;
+		}
+		if (__match_prefix_nocase(p, last, "nan")) {
+			res.ptr = p + 3;
+			value = negative ? -std::numeric_limits<Float>::quiet_NaN() : std::numeric_limits<Float>::quiet_NaN();
+			return res;
+		}
+
+		__parsed_number num;
+		const char* end = first;
+		if (!__parse_number(first, last, num, end)) {
+			res.ec = std::errc::invalid_argument;
+			return res;
+		}
+		res.ptr = end;
+
+		if (num.mantissa == 0 && !num.too_many_digits) {
+			value = num.negative ? -Float(0) : Float(0);
+			return res;
+		}
+		if (__fast_path(num, value))
+			return res;
+
+		//慢速路径
+		__decimal dec;
+		__init_decimal(dec, num);
+		bool overflow = false;
+		uint64_t bits = dec.float_bits(flt, overflow);
+		//上溢，或非0的数值舍入为0（下溢），与 std::from_chars 一致报告超出范围
+		const uint64_t sign_mask = uint64_t(1) << (flt.mantbits + flt.expbits);
+		if (overflow || (bits & ~sign_mask) == 0) {
+			res.ec = std::errc::result_out_of_range;
+			return res;
+		}
+		UInt ubits = UInt(bits);
+		memcpy(&value, &ubits, sizeof(Float));
+		return res;
+	}
+
+}// end of namespace detail
+
+
+/* from_chars 对外接口 */
+	/* 整数版本，base 取值 2~36 */
+	template<class Integer>
+	inline from_chars_result from_chars(const char* first, const char* last, Integer& value, int base = 10) {
+		return detail::__from_chars_integer(first, last, value, base);
+	}
+
+	/* double 版本 */
+	inline from_chars_result from_chars(const char* first, const char* last, double& value) {
+		static const detail::__float_info flt = { 52, 11, -1023 };
+		return detail::__from_chars_float<double, uint64_t>(first, last, value, flt);
+	}
+
+	/* float 版本 */
+	inline from_chars_result from_chars(const char* first, const char* last, float& value) {
+		static const detail::__float_info flt = { 23, 8, -127 };
+		return detail::__from_chars_float<float, uint32_t>(first, last, value, flt);
+	}
+
+	/* 以下直接在 lfp::string 的缓冲区上解析，返回的 ptr 指向 str 内部 */
+	template<class Integer>
+	inline from_chars_result from_chars(const string& str, Integer& value, int base = 10) {
+		return from_chars(str.data(), str.data() + str.size(), value, base);
+	}
+
+	inline from_chars_result from_chars(const string& str, double& value) {
+		return from_chars(str.data(), str.data() + str.size(), value);
+	}
+
+	inline from_chars_result from_chars(const string& str, float& value) {
+		return from_chars(str.data(), str.data() + str.size(), value);
+	}
+
+}// end of namespace lfp
+
+#endif // !_STL_CHARCONV_H_
@@ -0,0 +1,466 @@
+/*
+ *UTF-8 校验、码点计数以及 UTF-8 与 UTF-16/UTF-32 之间的相互转换
+ *
+ *所有函数都直接作用于 [first, last) 区间或 lfp::string 的缓冲区，不分配内存，不抛出异常。
+ *文本中绝大部分通常是 ASCII，因此以 16 字节为一块（SSE2）或 8 字节为一块（SWAR，没有 SSE2 时的
+ *退化方案）整块判断是否全为 ASCII，全为 ASCII 的块直接跳过或整块展开/收窄；遇到多字节序列时
+ *才逐个码点进行严格校验（拒绝过长编码、代理区码点、超出 U+10FFFF 的码点和截断的序列）
+ *
+ *定义 __STL_NO_SIMD 可以强制使用标量实现
+ */
+
+#ifndef _STL_UTF8_H_
+#define _STL_UTF8_H_
+
+#include "3stl_string.h"
+#include <cstddef>			//for size_t
+#include <stdint.h>			//for uint64_t
+#include <string.h>			//for memcpy
+
+#if defined(__SSE2__) && !defined(__STL_NO_SIMD)
+	#define __STL_UTF8_USE_SSE2
+	#include <emmintrin.h>
+#endif
+
+namespace lfp {
+
+	/* 错误类型 */
+	enum utf_error {
+		utf_ok = 0,
+		utf_too_short,		//多字节序列缺少后续字节
+		utf_too_long,		//出现了多余的后续字节(10xxxxxx)
+		utf_overlong,		//过长编码，例如用两个字节表示 ASCII
+		utf_too_large,		//码点超出 U+10FFFF 或首字节非法
+		utf_surrogate		//UTF-8/UTF-32 中出现了代理区码点，或 UTF-16 中代理项不成对
+	};
+
+	/* 校验和转换的结果：成功时 count 为写出的编码单元个数（校验时为输入长度），
+	   失败时 count 为出错位置在输入中的下标 */
+	struct utf_result {
+		utf_error error;
+		size_t count;
+	};
+
+namespace detail {
+
+	inline utf_result __utf_make_result(utf_error error, size_t count) {
+		utf_result res = { error, count };
+		return res;
+	}
+
+	inline bool __utf8_is_continuation(unsigned char c) {
+		return (c & 0xC0) == 0x80;
+	}
+
+	/* 严格解码 p 处的一个 UTF-8 码点，成功返回序列长度，失败返回0并设置 err */
+	inline int __utf8_decode(const unsigned char* p, const unsigned char* last, char32_t& cp, utf_error& err) {
+		unsigned char c = p[0];
+		if (c < 0x80) {
+			cp = c;
+			return 1;
+		}
+		if (c < 0xC0) {
+			err = utf_too_long;
+			return 0;
+		}
+		if (c < 0xC2) {		//0xC0 0xC1 只能产生过长编码
+			err = utf_overlong;
+			return 0;
+		}
+		if (c < 0xE0) {
+			if (last - p < 2 || !__utf8_is_continuation(p[1])) {
+				err = utf_too_short;
+				return 0;
+			}
+			cp = (char32_t(c & 0x1F) << 6) | (p[1] & 0x3F);
+			return 2;
+		}
+		if (c < 0xF0) {
+			if (last - p < 3 || !__utf8_is_continuation(p[1]) || !__utf8_is_continuation(p[2])) {
+				err = utf_too_short;
+				return 0;
+			}
+			cp = (char32_t(c & 0x0F) << 12) | (char32_t(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+			if (cp < 0x800) {
+				err = utf_overlong;
+				return 0;
+			}
+			if (cp >= 0xD800 && cp <= 0xDFFF) {
+				err = utf_surrogate;
+				return 0;
+			}
+			return 3;
+		}
+		if (c < 0xF5) {
+			if (last - p < 4 || !__utf8_is_continuation(p[1]) ||
+				!__utf8_is_continuation(p[2]) || !__utf8_is_continuation(p[3])) {
+				err = utf_too_short;
+				return 0;
+			}
+			cp = (char32_t(c & 0x07) << 18) | (char32_t(p[1] & 0x3F) << 12) |
+				 (char32_t(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+			if (cp < 0x10000) {
+				err = utf_overlong;
+				return 0;
+			}
+			if (cp > 0x10FFFF) {
+				err = utf_too_large;
+				return 0;
+			}
+			return 4;
+		}
+		err = utf_too_large;
+		return 0;
+	}
+
+	/* 将码点 cp 编码为 UTF-8 写入 out，返回写出的字节数 */
+	inline int __utf8_encode(char32_t cp, char* out) {
+		if (cp < 0x80) {
+			out[0] = char(cp);
+			return 1;
+		}
+		if (cp < 0x800) {
+			out[0] = char(0xC0 | (cp >> 6));
+			out[1] = char(0x80 | (cp & 0x3F));
+			return 2;
+		}
+		if (cp < 0x10000) {
+			out[0] = char(0xE0 | (cp >> 12));
+			out[1] = char(0x80 | ((cp >> 6) & 0x3F));
+			out[2] = char(0x80 | (cp & 0x3F));
+			return 3;
+		}
+		out[0] = char(0xF0 | (cp >> 18));
+		out[1] = char(0x80 | ((cp >> 12) & 0x3F));
+		out[2] = char(0x80 | ((cp >> 6) & 0x3F));
+		out[3] = char(0x80 | (cp & 0x3F));
+		return 4;
+	}
+
+
+/* 以下为整块处理 ASCII 的工具函数，block_size 为一块的字节数 */
+#ifdef __STL_UTF8_USE_SSE2
+	enum { __utf8_block_size = 16 };
+
+	inline bool __utf8_block_is_ascii(const unsigned char* p) {
+		__m128i v = _mm_loadu_si128((const __m128i*)p);
+		return _mm_movemask_epi8(v) == 0;		//每个字节的最高位都为0
+	}
+
+	//统计一块中非后续字节(不是10xxxxxx)的个数，即一块中码点的起始个数
+	inline int __utf8_block_count_leading(const unsigned char* p) {
+		__m128i v = _mm_loadu_si128((const __m128i*)p);
+		//有符号比较：后续字节 0x80~0xBF 即 -128~-65
+		__m128i leading = _mm_cmpgt_epi8(v, _mm_set1_epi8(-65));
+		return __builtin_popcount(_mm_movemask_epi8(leading));
+	}
+
+	//将一块 ASCII 展开为 UTF-16
+	inline void __utf8_block_widen(const unsigned char* p, char16_t* out) {
+		__m128i v = _mm_loadu_si128((const __m128i*)p);
+		__m128i zero = _mm_setzero_si128();
+		_mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi8(v, zero));
+		_mm_storeu_si128((__m128i*)(out + 8), _mm_unpackhi_epi8(v, zero));
+	}
+
+	//将一块 ASCII 展开为 UTF-32
+	inline void __utf8_block_widen(const unsigned char* p, char32_t* out) {
+		__m128i v = _mm_loadu_si128((const __m128i*)p);
+		__m128i zero = _mm_setzero_si128();
+		__m128i lo = _mm_unpacklo_epi8(v, zero);
+		__m128i hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i*)(out + 4), _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i*)(out + 8), _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i*)(out + 12), _mm_unpackhi_epi16(hi, zero));
+	}
+
+	//若 8 个 UTF-16 单元全为 ASCII，则收窄写入 out 并返回 true
+	inline bool __utf16_block_narrow(const char16_t* p, char* out) {
+		__m128i v = _mm_loadu_si128((const __m128i*)p);
+		__m128i high = _mm_and_si128(v, _mm_set1_epi16((short)0xFF80));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF)
+			return false;
+		_mm_storel_epi64((__m128i*)out, _mm_packus_epi16(v, v));
+		return true;
+	}
+	enum { __utf16_block_size = 8 };
+
+	//若 4 个 UTF-32 单元全为 ASCII，则收窄写入 out 并返回 true
+	inline bool __utf32_block_narrow(const char32_t* p, char* out) {
+		__m128i v = _mm_loadu_si128((const __m128i*)p);
+		__m128i high = _mm_and_si128(v, _mm_set1_epi32((int)0xFFFFFF80));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) != 0xFFFF)
+			return false;
+		__m128i w = _mm_packs_epi32(v, v);		//值都小于 0x80，有符号饱和不会改变数值
+		w = _mm_packus_epi16(w, w);
+		int word = _mm_cvtsi128_si32(w);
+		memcpy(out, &word, 4);
+		return true;
+	}
+	enum { __utf32_block_size = 4 };
+
+#else	//SWAR 实现，一次处理 8 个字节
+	enum { __utf8_block_size = 8 };
+
+	inline uint64_t __utf8_load_block(const unsigned char* p) {
+		uint64_t v;
+		memcpy(&v, p, sizeof(uint64_t));
+		return v;
+	}
+
+	inline bool __utf8_block_is_ascii(const unsigned char* p) {
+		return (__utf8_load_block(p) & 0x8080808080808080ull) == 0;
+	}
+
+	inline int __utf8_block_count_leading(const unsigned char* p) {
+		uint64_t v = __utf8_load_block(p);
+		//后续字节的最高两位为 10：最高位为1，次高位为0
+		uint64_t continuation = v & (~v << 1) & 0x8080808080808080ull;
+		return 8 - __builtin_popcountll(continuation);
+	}
+
+	inline void __utf8_block_widen(const unsigned char* p, char16_t* out) {
+		for (int i = 0; i < 8; ++i)
+			out[i] = p[i];
+	}
+
+	inline void __utf8_block_widen(const unsigned char* p, char32_t* out) {
+		for (int i = 0; i < 8; ++i)
+			out[i] = p[i];
+	}
+
+	inline bool __utf16_block_narrow(const char16_t* p, char* out) {
+		char16_t bits = 0;
+		for (int i = 0; i < 4; ++i)
+			bits |= p[i];
+		if (bits >= 0x80)
+			return false;
+		for (int i = 0; i < 4; ++i)
+			out[i] = char(p[i]);
+		return true;
+	}
+	enum { __utf16_block_size = 4 };
+
+	inline bool __utf32_block_narrow(const char32_t* p, char* out) {
+		char32_t bits = 0;
+		for (int i = 0; i < 4; ++i)
+			bits |= p[i];
+		if (bits >= 0x80)
+			return false;
+		for (int i = 0; i < 4; ++i)
+			out[i] = char(p[i]);
+		return true;
+	}
+	enum { __utf32_block_size = 4 };
+#endif
+
+	/* UTF-8 转 UTF-16/UTF-32 的公共实现，CharT 为 char16_t 或 char32_t */
+	template<class CharT>
+	utf_result __convert_utf8(const char* first, const char* last, CharT* out) {
+		const unsigned char* p = (const unsigned char*)first;
+		const unsigned char* end = (const unsigned char*)last;
+		CharT* start = out;
+
+		while (p != end) {
+			if (end - p >= __utf8_block_size && __utf8_block_is_ascii(p)) {
+				__utf8_block_widen(p, out);
+				p += __utf8_block_size;
+				out += __utf8_block_size;
+				continue;
+			}
+
+			char32_t cp = 0;
+			utf_error err = utf_ok;
+			int len = __utf8_decode(p, end, cp, err);
+			if (len == 0)
+				return __utf_make_result(err, p - (const unsigned char*)first);
+			p += len;
+
+			if (sizeof(CharT) == 2 && cp >= 0x10000) {		//UTF-16 需要拆成代理对
+				cp -= 0x10000;
+				*out++ = CharT(0xD800 + (cp >> 10));
+				*out++ = CharT(0xDC00 + (cp & 0x3FF));
+			}
+			else {
+				*out++ = CharT(cp);
+			}
+		}
+		return __utf_make_result(utf_ok, out - start);
+	}
+
+}// end of namespace detail
+
+
+/* 校验 */
+	/* 校验 [first, last) 是否为合法的 UTF-8，失败时 count 为第一个非法序列的位置 */
+	inline utf_result validate_utf8(const char* first, const char* last) {
+		const unsigned char* p = (const unsigned char*)first;
+		const unsigned char* end = (const unsigned char*)last;
+
+		while (p != end) {
+			if (end - p >= detail::__utf8_block_size && detail::__utf8_block_is_ascii(p)) {
+				p += detail::__utf8_block_size;		//整块 ASCII 直接跳过
+				continue;
+			}
+			char32_t cp = 0;
+			utf_error err = utf_ok;
+			int len = detail::__utf8_decode(p, end, cp, err);
+			if (len == 0)
+				return detail::__utf_make_result(err, p - (const unsigned char*)first);
+			p += len;
+		}
+		return detail::__utf_make_result(utf_ok, last - first);
+	}
+
+	inline utf_result validate_utf8(const string& str) {
+		return validate_utf8(str.data(), str.data() + str.size());
+	}
+
+	inline bool is_valid_utf8(const char* first, const char* last) {
+		return validate_utf8(first, last).error == utf_ok;
+	}
+
+	inline bool is_valid_utf8(const string& str) {
+		return validate_utf8(str).error == utf_ok;
+	}
+
+
+/* 计数 */
+	/* 统计码点个数，要求输入为合法的 UTF-8（即统计非后续字节的个数） */
+	inline size_t count_utf8(const char* first, const char* last) {
+		const unsigned char* p = (const unsigned char*)first;
+		const unsigned char* end = (const unsigned char*)last;
+		size_t count = 0;
+
+		while (end - p >= detail::__utf8_block_size) {
+			count += detail::__utf8_block_count_leading(p);
+			p += detail::__utf8_block_size;
+		}
+		for (; p != end; ++p) {
+			if (!detail::__utf8_is_continuation(*p))
+				++count;
+		}
+		return count;
+	}
+
+	inline size_t count_utf8(const string& str) {
+		return count_utf8(str.data(), str.data() + str.size());
+	}
+
+	/* 合法的 UTF-8 转换为 UTF-16 后的长度：每个码点一个单元，四字节序列需要两个单元 */
+	inline size_t utf16_length_from_utf8(const char* first, const char* last) {
+		size_t count = count_utf8(first, last);
+		for (const unsigned char* p = (const unsigned char*)first; p != (const unsigned char*)last; ++p) {
+			if (*p >= 0xF0)
+				++count;
+		}
+		return count;
+	}
+
+	/* 合法的 UTF-8 转换为 UTF-32 后的长度即码点个数 */
+	inline size_t utf32_length_from_utf8(const char* first, const char* last) {
+		return count_utf8(first, last);
+	}
+
+	/* 合法的 UTF-16 转换为 UTF-8 后的字节数 */
+	inline size_t utf8_length_from_utf16(const char16_t* first, const char16_t* last) {
+		size_t count = 0;
+		for (; first != last; ++first) {
+			char16_t c = *first;
+			if (c < 0x80)
+				count += 1;
+			else if (c < 0x800)
+				count += 2;
+			else if (c >= 0xD800 && c <= 0xDBFF)	//高代理项与低代理项合计 4 个字节
+				count += 2;
+			else if (c >= 0xDC00 && c <= 0xDFFF)
+				count += 2;
+			else
+				count += 3;
+		}
+		return count;
+	}
+
+	/* 合法的 UTF-32 转换为 UTF-8 后的字节数 */
+	inline size_t utf8_length_from_utf32(const char32_t* first, const char32_t* last) {
+		size_t count = 0;
+		for (; first != last; ++first) {
+			char32_t c = *first;
+			count += (c < 0x80) ? 1 : (c < 0x800) ? 2 : (c < 0x10000) ? 3 : 4;
+		}
+		return count;
+	}
+
+
+/* 转换：out 的空间由调用者保证（可用以上 *_length_from_* 函数求得），转换的同时进行严格校验 */
+	inline utf_result convert_utf8_to_utf16(const char* first, const char* last, char16_t* out) {
+		return detail::__convert_utf8(first, last, out);
+	}
+
+	inline utf_result convert_utf8_to_utf16(const string& str, char16_t* out) {
+		return convert_utf8_to_utf16(str.data(), str.data() + str.size(), out);
+	}
+
+	inline utf_result convert_utf8_to_utf32(const char* first, const char* last, char32_t* out) {
+		return detail::__convert_utf8(first, last, out);
+	}
+
+	inline utf_result convert_utf8_to_utf32(const string& str, char32_t* out) {
+		return convert_utf8_to_utf32(str.data(), str.data() + str.size(), out);
+	}
+
+	inline utf_result convert_utf16_to_utf8(const char16_t* first, const char16_t* last, char* out) {
+		const char16_t* p = first;
+		char* start = out;
+
+		while (p != last) {
+			if (last - p >= detail::__utf16_block_size && detail::__utf16_block_narrow(p, out)) {
+				p += detail::__utf16_block_size;
+				out += detail::__utf16_block_size;
+				continue;
+			}
+
+			char32_t cp = *p;
+			if (cp >= 0xD800 && cp <= 0xDBFF) {		//高代理项后必须紧跟低代理项
+				if (last - p < 2 || p[1] < 0xDC00 || p[1] > 0xDFFF)
+					return detail::__utf_make_result(utf_surrogate, p - first);
+				cp = 0x10000 + ((cp - 0xD800) << 10) + (p[1] - 0xDC00);
+				p += 2;
+			}
+			else if (cp >= 0xDC00 && cp <= 0xDFFF) {	//单独出现的低代理项
+				return detail::__utf_make_result(utf_surrogate, p - first);
+			}
+			else {
+				++p;
+			}
+			out += detail::__utf8_encode(cp, out);
+		}
+		return detail::__utf_make_result(utf_ok, out - start);
+	}
+
+	inline utf_result convert_utf32_to_utf8(const char32_t* first, const char32_t* last, char* out) {
+		const char32_t* p = first;
+		char* start = out;
+
+		while (p != last) {
+			if (last - p >= detail::__utf32_block_size && detail::__utf32_block_narrow(p, out)) {
+				p += detail::__utf32_block_size;
+				out += detail::__utf32_block_size;
+				continue;
+			}
+
+			char32_t cp = *p;
+			if (cp > 0x10FFFF)
+				return detail::__utf_make_result(utf_too_large, p - first);
+			if (cp >= 0xD800 && cp <= 0xDFFF)
+				return detail::__utf_make_result(utf_surrogate, p - first);
+			out += detail::__utf8_encode(cp, out);
+			++p;
+		}
+		return detail::__utf_make_result(utf_ok, out - start);
+	}
+
+}// end of namespace lfp
+
+#endif // !_STL_UTF8_H_
@@ -0,0 +1,241 @@
+/*
+ *hash函数族
+ *
+ *可直接作为 hashtable 以及 hash_* 系列容器的 HashFunc 参数：
+ *	整数、字符、bool：	64位雪崩混合（splitmix64 的终结函数），连续的键值在低位也能均匀分布
+ *	指针：				先去掉对齐造成的恒为0的低位再做混合
+ *	lfp::string 和字符区间：	wyhash 风格的字节 hash，按 16/48 字节一组做 64x64->128 位乘法混合
+ *	std::pair、std::tuple：	逐个元素 hash 后用不对称的混合函数组合，(a, b) 与 (b, a) 结果不同
+ *其他类型退回 std::hash
+ */
+
+#ifndef _STL_HASH_FUN_H_
+#define _STL_HASH_FUN_H_
+
+#include "3stl_string.h"
+#include <cstddef>			//for size_t
+#include <stdint.h>			//for uint64_t
+#include <string.h>			//for memcpy strlen
+#include <functional>		//for std::hash
+#include <utility>			//for pair
+#include <tuple>
+
+namespace lfp {
+
+namespace detail {
+
+	//wyhash 使用的默认密钥，每个都是奇数且各字节中1的个数均为4
+	static const uint64_t __hash_secret[4] = {
+		0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+		0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+	};
+
+	/* 64x64->128 位乘法，低64位写回 a，高64位写回 b */
+	inline void __hash_mum(uint64_t& a, uint64_t& b) {
+#ifdef __SIZEOF_INT128__
+		unsigned __int128 r = a;
+		r *= b;
+		a = (uint64_t)r;
+		b = (uint64_t)(r >> 64);
+#else
+		uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t)a, lb = (uint32_t)b;
+		uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+		uint64_t t = rl + (rm0 << 32);
+		uint64_t c = t < rl;
+		uint64_t lo = t + (rm1 << 32);
+		c += lo < t;
+		uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+		a = lo;
+		b = hi;
+#endif
+	}
+
+	/* 128位乘积的高低两半异或，是 wyhash 的基本混合步骤 */
+	inline uint64_t __hash_mix(uint64_t a, uint64_t b) {
+		__hash_mum(a, b);
+		return a ^ b;
+	}
+
+	inline uint64_t __hash_read8(const unsigned char* p) {
+		uint64_t v;
+		memcpy(&v, p, 8);
+		return v;
+	}
+
+	inline uint64_t __hash_read4(const unsigned char* p) {
+		uint32_t v;
+		memcpy(&v, p, 4);
+		return v;
+	}
+
+	//读取 1~3 个字节：首、中、尾各取一个字节
+	inline uint64_t __hash_read3(const unsigned char* p, size_t k) {
+		return (uint64_t(p[0]) << 16) | (uint64_t(p[k >> 1]) << 8) | p[k - 1];
+	}
+
+	/* 字节序列的 hash（wyhash） */
+	inline uint64_t __hash_bytes(const void* key, size_t len, uint64_t seed) {
+		const unsigned char* p = (const unsigned char*)key;
+		const uint64_t* secret = __hash_secret;
+		seed ^= __hash_mix(seed ^ secret[0], secret[1]);
+		uint64_t a, b;
+
+		if (len <= 16) {
+			if (len >= 4) {		//两次读取可能重叠，但覆盖了全部字节
+				a = (__hash_read4(p) << 32) | __hash_read4(p + ((len >> 3) << 2));
+				b = (__hash_read4(p + len - 4) << 32) | __hash_read4(p + len - 4 - ((len >> 3) << 2));
+			}
+			else if (len > 0) {
+				a = __hash_read3(p, len);
+				b = 0;
+			}
+			else {
+				a = b = 0;
+			}
+		}
+		else {
+			size_t i = len;
+			if (i > 48) {		//长串用三条独立的链并行混合
+				uint64_t see1 = seed, see2 = seed;
+				do {
+					seed = __hash_mix(__hash_read8(p) ^ secret[1], __hash_read8(p + 8) ^ seed);
+					see1 = __hash_mix(__hash_read8(p + 16) ^ secret[2], __hash_read8(p + 24) ^ see1);
+					see2 = __hash_mix(__hash_read8(p + 32) ^ secret[3], __hash_read8(p + 40) ^ see2);
+					p += 48;
+					i -= 48;
+				} while (i > 48);
+				seed ^= see1 ^ see2;
+			}
+			while (i > 16) {
+				seed = __hash_mix(__hash_read8(p) ^ secret[1], __hash_read8(p + 8) ^ seed);
+				i -= 16;
+				p += 16;
+			}
+			a = __hash_read8(p + i - 16);		//最后16个字节，可能与前面重叠
+			b = __hash_read8(p + i - 8);
+		}
+
+		a ^= secret[1];
+		b ^= seed;
+		__hash_mum(a, b);
+		return __hash_mix(a ^ secret[0] ^ len, b ^ secret[1]);
+	}
+
+	/* 整数的雪崩混合：任意一位输入的变化以约 1/2 的概率翻转每一位输出 */
+	inline uint64_t __hash_int(uint64_t x) {
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ull;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebull;
+		x ^= x >> 31;
+		return x;
+	}
+
+}// end of namespace detail
+
+
+/* 公共函数 */
+	/* 对任意字节序列求 hash */
+	inline size_t hash_bytes(const void* key, size_t len, uint64_t seed = 0) {
+		return (size_t)detail::__hash_bytes(key, len, seed);
+	}
+
+	/* 对字符区间 [first, last) 求 hash。不与 hash_bytes 重载，以免 hash_bytes(p, 0) 把 0 当作 last */
+	inline size_t hash_range(const char* first, const char* last) {
+		return hash_bytes(first, size_t(last - first));
+	}
+
+	/* 将 h 组合进 seed，组合顺序不同结果不同 */
+	inline size_t hash_combine(size_t seed, size_t h) {
+		return (size_t)detail::__hash_mix(uint64_t(seed) ^ detail::__hash_secret[0], uint64_t(h) ^ detail::__hash_secret[1]);
+	}
+
+
+/* hash 仿函数 */
+	//缺省退回 std::hash
+	template<class Key>
+	struct hash : public std::hash<Key> { };
+
+	//整数类型
+	#define __STL_DEFINE_INT_HASH(Type)						\
+	template<>												\
+	struct hash<Type> {										\
+		size_t operator()(Type x) const {					\
+			return (size_t)detail::__hash_int(uint64_t(x));	\
+		}													\
+	};
+
+	__STL_DEFINE_INT_HASH(bool)
+	__STL_DEFINE_INT_HASH(char)
+	__STL_DEFINE_INT_HASH(signed char)
+	__STL_DEFINE_INT_HASH(unsigned char)
+	__STL_DEFINE_INT_HASH(wchar_t)
+	__STL_DEFINE_INT_HASH(char16_t)
+	__STL_DEFINE_INT_HASH(char32_t)
+	__STL_DEFINE_INT_HASH(short)
+	__STL_DEFINE_INT_HASH(unsigned short)
+	__STL_DEFINE_INT_HASH(int)
+	__STL_DEFINE_INT_HASH(unsigned int)
+	__STL_DEFINE_INT_HASH(long)
+	__STL_DEFINE_INT_HASH(unsigned long)
+	__STL_DEFINE_INT_HASH(long long)
+	__STL_DEFINE_INT_HASH(unsigned long long)
+
+	#undef __STL_DEFINE_INT_HASH
+
+	//指针：按地址求 hash（与 equal_to<T*> 的语义一致），而不是按所指的字符串内容
+	template<class T>
+	struct hash<T*> {
+		size_t operator()(T* p) const {
+			return (size_t)detail::__hash_int(uint64_t(uintptr_t(p)) >> 3);
+		}
+	};
+
+	//lfp::string：按内容求 hash
+	template<>
+	struct hash<string> {
+		size_t operator()(const string& str) const {
+			return hash_bytes(str.data(), str.size());
+		}
+	};
+
+	//std::pair
+	template<class T1, class T2>
+	struct hash<std::pair<T1, T2>> {
+		size_t operator()(const std::pair<T1, T2>& p) const {
+			return hash_combine(hash<T1>()(p.first), hash<T2>()(p.second));
+		}
+	};
+
+namespace detail {
+
+	//从第 I 个元素开始依次组合 tuple 中各元素的 hash
+	template<class Tuple, size_t I, size_t N>
+	struct __tuple_hash {
+		static size_t apply(size_t seed, const Tuple& t) {
+			typedef typename std::tuple_element<I, Tuple>::type elem_type;
+			seed = hash_combine(seed, hash<elem_type>()(std::get<I>(t)));
+			return __tuple_hash<Tuple, I + 1, N>::apply(seed, t);
+		}
+	};
+
+	template<class Tuple, size_t N>
+	struct __tuple_hash<Tuple, N, N> {
+		static size_t apply(size_t seed, const Tuple&) {
+			return seed;
+		}
+	};
+
+}// end of namespace detail
+
+	//std::tuple
+	template<class... Types>
+	struct hash<std::tuple<Types...>> {
+		size_t operator()(const std::tuple<Types...>& t) const {
+			return detail::__tuple_hash<std::tuple<Types...>, 0, sizeof...(Types)>::apply(sizeof...(Types), t);
+		}
+	};
+
+}// end of namespace lfp
+
+#endif // !_STL_HASH_FUN_H_
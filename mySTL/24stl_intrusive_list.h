@@ -0,0 +1,287 @@
+/*
+ *intrusive_list实现，侵入式双向链表
+ *
+ *与list不同，链接指针（intrusive_list_node）存放在使用者自己的对象之内，容器只负责把这些对象串起来：
+ *插入、移除、接合都只调整指针，从不配置或释放内存，也不复制、不析构元素。元素的生命周期由使用者管理，
+ *元素在链表中时必须保持地址不变，销毁之前必须先从链表中移除
+ *
+ *使用方法有两种（Hook 参数）：
+ *	1. 让 T 继承 intrusive_list_node，使用缺省的 intrusive_base_hook
+ *	2. 让 T 拥有一个 intrusive_list_node 成员，使用 intrusive_member_hook<T, intrusive_list_node, &T::member>
+ *一个对象可以拥有多个节点成员，从而同时位于多个链表之中
+ */
+
+#ifndef _STL_INTRUSIVE_LIST_H_
+#define _STL_INTRUSIVE_LIST_H_
+
+#include "1stl_iterator.h"		//for bidirectional_iterator_tag
+#include <cstddef>				//for ptrdiff_t size_t
+
+namespace lfp {
+
+/* 以下是链接节点，嵌入在使用者的对象之中 */
+	struct intrusive_list_node {
+		intrusive_list_node* prev;
+		intrusive_list_node* next;
+
+		intrusive_list_node() : prev(0), next(0) { }
+		//复制对象时不复制链接关系：副本不在任何链表之中
+		intrusive_list_node(const intrusive_list_node&) : prev(0), next(0) { }
+		intrusive_list_node& operator=(const intrusive_list_node&) { return *this; }
+
+		//是否位于某个链表之中
+		bool is_linked() const { return next != 0; }
+	};
+
+
+/* 以下是 Hook：描述如何在元素与其链接节点之间相互转换 */
+	//T 继承自 Node
+	template<class T, class Node>
+	struct intrusive_base_hook {
+		static Node* to_node(T* value) { return static_cast<Node*>(value); }
+		static const Node* to_node(const T* value) { return static_cast<const Node*>(value); }
+		static T* to_value(Node* node) { return static_cast<T*>(node); }
+		static const T* to_value(const Node* node) { return static_cast<const T*>(node); }
+	};
+
+	//Node 是 T 的成员 Member
+	template<class T, class Node, Node T::*Member>
+	struct intrusive_member_hook {
+		static Node* to_node(T* value) { return &(value->*Member); }
+		static const Node* to_node(const T* value) { return &(value->*Member); }
+		static T* to_value(Node* node) { return (T*)((char*)node - offset()); }
+		static const T* to_value(const Node* node) { return (const T*)((const char*)node - offset()); }
+
+	private:
+		//成员在对象中的偏移量。使用一个非空的假想地址，避免对空指针取成员
+		static ptrdiff_t offset() {
+			T* dummy = (T*)sizeof(T);
+			return (char*)&(dummy->*Member) - (char*)dummy;
+		}
+	};
+
+
+namespace detail {
+
+	//全局函数，将 [first, last) 内的节点接合于 pos 之前，做法与 list::transfer 相同
+	inline void __intrusive_list_transfer(
+		intrusive_list_node* pos,
+		intrusive_list_node* first,
+		intrusive_list_node* last)
+	{
+		if (pos != last) {
+			last->prev->next = pos;
+			first->prev->next = last;
+			pos->prev->next = first;
+			intrusive_list_node* tmp = pos->prev;
+			pos->prev = last->prev;
+			last->prev = first->prev;
+			first->prev = tmp;
+		}
+	}
+
+/* 以下是 intrusive_list 迭代器设计，型别为双向迭代器 */
+	template<class T, class Ref, class Ptr, class Hook>
+	struct __intrusive_list_iterator {
+		typedef __intrusive_list_iterator<T, Ref, Ptr, Hook>			self;
+		typedef __intrusive_list_iterator<T, T&, T*, Hook>				iterator;
+		typedef __intrusive_list_iterator<T, const T&, const T*, Hook>	const_iterator;
+		typedef bidirectional_iterator_tag		iterator_category;
+		typedef T								value_type;
+		typedef Ptr								pointer;
+		typedef Ref								reference;
+		typedef size_t							size_type;
+		typedef ptrdiff_t						difference_type;
+
+		intrusive_list_node* node;
+
+		__intrusive_list_iterator() : node(0) { }
+		explicit __intrusive_list_iterator(intrusive_list_node* x) : node(x) { }
+		__intrusive_list_iterator(const iterator& x) : node(x.node) { }
+
+		bool operator==(const self& x) const { return node == x.node; }
+		bool operator!=(const self& x) const { return node != x.node; }
+		reference operator*() const { return *Hook::to_value(node); }
+		pointer operator->() const { return &(operator*()); }
+		self& operator++() {
+			node = node->next;
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+		self& operator--() {
+			node = node->prev;
+			return *this;
+		}
+		self operator--(int) {
+			self tmp = *this;
+			--*this;
+			return tmp;
+		}
+	};
+
+}// end of namespace detail
+
+
+
+/*	以下是 intrusive_list 结构的实现，双向循环链表，header 为尾端后面的空白节点	*/
+	template<class T, class Hook = intrusive_base_hook<T, intrusive_list_node> >
+	struct intrusive_list {
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef size_t			size_type;
+		typedef ptrdiff_t		difference_type;
+		typedef typename detail::__intrusive_list_iterator<T, T&, T*, Hook>::iterator			iterator;
+		typedef typename detail::__intrusive_list_iterator<T, T&, T*, Hook>::const_iterator		const_iterator;
+
+	private:
+		intrusive_list_node header;		//注意这是实体，元素的节点会指向它，因此容器不可复制
+		size_type size_;
+
+		intrusive_list(const intrusive_list&);
+		intrusive_list& operator=(const intrusive_list&);
+
+		//将节点恢复为未链接状态
+		static void unlink_node(intrusive_list_node* node) {
+			node->prev = 0;
+			node->next = 0;
+		}
+
+	public:
+		intrusive_list() : size_(0) {
+			header.next = &header;
+			header.prev = &header;
+		}
+		~intrusive_list() { clear(); }
+
+		iterator begin() { return iterator(header.next); }
+		const_iterator begin() const { return const_iterator(iterator(const_cast<intrusive_list_node*>(header.next))); }
+		iterator end() { return iterator(&header); }
+		const_iterator end() const { return const_iterator(iterator(const_cast<intrusive_list_node*>(&header))); }
+		bool empty() const { return header.next == &header; }
+		size_type size() const { return size_; }
+
+		reference front() { return *begin(); }
+		const_reference front() const { return *begin(); }
+		reference back() { return *(--end()); }
+		const_reference back() const { return *(--end()); }
+
+		//由元素得到指向它的迭代器，O(1)。元素必须位于某个此类链表之中
+		static iterator iterator_to(reference x) { return iterator(Hook::to_node(&x)); }
+		static const_iterator iterator_to(const_reference x) {
+			return const_iterator(iterator(const_cast<intrusive_list_node*>(Hook::to_node(&x))));
+		}
+
+		//将 x 链接到 pos 之前，x 必须不在任何此类链表之中，返回指向 x 的迭代器
+		iterator insert(iterator pos, reference x) {
+			intrusive_list_node* tmp = Hook::to_node(&x);
+			tmp->next = pos.node;
+			tmp->prev = pos.node->prev;
+			pos.node->prev->next = tmp;
+			pos.node->prev = tmp;
+			++size_;
+			return iterator(tmp);
+		}
+
+		//将 pos 所指元素从链表中移除（不析构），返回下一个位置
+		iterator erase(iterator pos) {
+			intrusive_list_node* next_node = pos.node->next;
+			intrusive_list_node* prev_node = pos.node->prev;
+			prev_node->next = next_node;
+			next_node->prev = prev_node;
+			unlink_node(pos.node);
+			--size_;
+			return iterator(next_node);
+		}
+		iterator erase(iterator first, iterator last) {
+			while (first != last)
+				first = erase(first);
+			return last;
+		}
+		//将 x 从本链表中移除
+		void remove(reference x) { erase(iterator_to(x)); }
+
+		void push_front(reference x) { insert(begin(), x); }
+		void push_back(reference x) { insert(end(), x); }
+		void pop_front() { erase(begin()); }
+		void pop_back() { erase(--end()); }
+
+		//移除所有元素（不析构），使它们都恢复为未链接状态
+		void clear() {
+			intrusive_list_node* cur = header.next;
+			while (cur != &header) {
+				intrusive_list_node* tmp = cur;
+				cur = cur->next;
+				unlink_node(tmp);
+			}
+			header.next = &header;
+			header.prev = &header;
+			size_ = 0;
+		}
+
+		//交换两个链表的内容。由于元素指向各自的 header，需要修正首尾元素的指针
+		void swap(intrusive_list& x) {
+			intrusive_list tmp;
+			tmp.splice(tmp.end(), x);
+			x.splice(x.end(), *this);
+			splice(end(), tmp);
+		}
+
+		/* 以下接合操作只调整指针 */
+		//将 x 的全部元素接合于 pos 之前，x 必须不同于 *this
+		void splice(iterator pos, intrusive_list& x) {
+			if (!x.empty()) {
+				detail::__intrusive_list_transfer(pos.node, x.header.next, &x.header);
+				size_ += x.size_;
+				x.size_ = 0;
+			}
+		}
+		//将 x 中 i 所指的元素接合于 pos 之前，x 可以就是 *this
+		void splice(iterator pos, intrusive_list& x, iterator i) {
+			iterator j = i;
+			++j;
+			if (pos == i || pos == j)
+				return;
+			detail::__intrusive_list_transfer(pos.node, i.node, j.node);
+			++size_;
+			--x.size_;
+		}
+		//将 x 中 [first, last) 内的元素接合于 pos 之前，pos 不能位于该区间之内
+		//x 就是 *this 时为 O(1)，否则需要统计接合的元素个数
+		void splice(iterator pos, intrusive_list& x, iterator first, iterator last) {
+			if (first == last)
+				return;
+			if (&x != this) {
+				size_type n = 0;
+				for (iterator it = first; it != last; ++it)
+					++n;
+				size_ += n;
+				x.size_ -= n;
+			}
+			detail::__intrusive_list_transfer(pos.node, first.node, last.node);
+		}
+
+		//将本链表的内容逆向重置
+		void reverse() {
+			if (size_ < 2)
+				return;
+			iterator first = begin();
+			++first;
+			while (first != end()) {
+				iterator old = first;
+				++first;
+				detail::__intrusive_list_transfer(header.next, old.node, first.node);
+			}
+		}
+	};
+
+}// end of namespace lfp
+
+#endif // !_STL_INTRUSIVE_LIST_H_
@@ -0,0 +1,225 @@
+/*
+ *intrusive_slist实现，侵入式单向链表
+ *
+ *链接指针（intrusive_slist_node）存放在使用者自己的对象之内，插入、移除、接合都只调整指针，
+ *从不配置或释放内存。与 slist 一样只提供 insert_after、erase_after、push_front 等操作
+ *
+ *Hook 参数的用法与 intrusive_list 相同（详见24stl_intrusive_list.h）：
+ *	1. 让 T 继承 intrusive_slist_node，使用缺省的 intrusive_base_hook
+ *	2. 让 T 拥有一个 intrusive_slist_node 成员，使用 intrusive_member_hook<T, intrusive_slist_node, &T::member>
+ */
+
+#ifndef _STL_INTRUSIVE_SLIST_H_
+#define _STL_INTRUSIVE_SLIST_H_
+
+#include "1stl_iterator.h"				//for forward_iterator_tag
+#include "24stl_intrusive_list.h"		//for intrusive_base_hook intrusive_member_hook
+#include <cstddef>						//for ptrdiff_t size_t
+
+namespace lfp {
+
+/* 以下是链接节点，嵌入在使用者的对象之中 */
+	struct intrusive_slist_node {
+		intrusive_slist_node* next;
+
+		intrusive_slist_node() : next(0) { }
+		//复制对象时不复制链接关系
+		intrusive_slist_node(const intrusive_slist_node&) : next(0) { }
+		intrusive_slist_node& operator=(const intrusive_slist_node&) { return *this; }
+	};
+
+
+namespace detail {
+
+	//全局函数，将 (before_first, before_last] 内的节点接合于 pos 之后，做法与 slist 相同
+	inline void __intrusive_slist_splice_after(
+		intrusive_slist_node* pos,
+		intrusive_slist_node* before_first,
+		intrusive_slist_node* before_last)
+	{
+		if (pos != before_first && pos != before_last) {
+			intrusive_slist_node* first = before_first->next;
+			intrusive_slist_node* after = pos->next;
+			before_first->next = before_last->next;
+			pos->next = first;
+			before_last->next = after;
+		}
+	}
+
+/* 以下是 intrusive_slist 迭代器设计，型别为单向迭代器 */
+	template<class T, class Ref, class Ptr, class Hook>
+	struct __intrusive_slist_iterator {
+		typedef __intrusive_slist_iterator<T, Ref, Ptr, Hook>				self;
+		typedef __intrusive_slist_iterator<T, T&, T*, Hook>					iterator;
+		typedef __intrusive_slist_iterator<T, const T&, const T*, Hook>		const_iterator;
+		typedef forward_iterator_tag			iterator_category;
+		typedef T								value_type;
+		typedef Ptr								pointer;
+		typedef Ref								reference;
+		typedef size_t							size_type;
+		typedef ptrdiff_t						difference_type;
+
+		intrusive_slist_node* node;
+
+		__intrusive_slist_iterator() : node(0) { }
+		explicit __intrusive_slist_iterator(intrusive_slist_node* x) : node(x) { }
+		__intrusive_slist_iterator(const iterator& x) : node(x.node) { }
+
+		bool operator==(const self& x) const { return node == x.node; }
+		bool operator!=(const self& x) const { return node != x.node; }
+		reference operator*() const { return *Hook::to_value(node); }
+		pointer operator->() const { return &(operator*()); }
+		self& operator++() {
+			node = node->next;
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+	};
+
+}// end of namespace detail
+
+
+
+/* 以下是 intrusive_slist 结构的实现，链表以空指针结尾 */
+	template<class T, class Hook = intrusive_base_hook<T, intrusive_slist_node> >
+	struct intrusive_slist {
+	public:
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef size_t			size_type;
+		typedef ptrdiff_t		difference_type;
+		typedef typename detail::__intrusive_slist_iterator<T, T&, T*, Hook>::iterator			iterator;
+		typedef typename detail::__intrusive_slist_iterator<T, T&, T*, Hook>::const_iterator	const_iterator;
+
+	private:
+		intrusive_slist_node dummyHead;		//头部，注意这是实体而不是指针
+		size_type node_count;
+
+		intrusive_slist(const intrusive_slist&);
+		intrusive_slist& operator=(const intrusive_slist&);
+
+	public:
+		intrusive_slist() : node_count(0) { }
+		~intrusive_slist() { clear(); }
+
+		//第一个元素之前的位置，用于在头部 insert_after、splice_after
+		iterator before_begin() { return iterator(&dummyHead); }
+		const_iterator before_begin() const { return const_iterator(iterator(const_cast<intrusive_slist_node*>(&dummyHead))); }
+		iterator begin() { return iterator(dummyHead.next); }
+		const_iterator begin() const { return const_iterator(iterator(dummyHead.next)); }
+		iterator end() { return iterator(0); }
+		const_iterator end() const { return const_iterator(iterator(0)); }
+
+		bool empty() const { return dummyHead.next == 0; }
+		size_type size() const { return node_count; }
+
+		reference front() { return *begin(); }
+		const_reference front() const { return *begin(); }
+
+		//由元素得到指向它的迭代器，O(1)
+		static iterator iterator_to(reference x) { return iterator(Hook::to_node(&x)); }
+		static const_iterator iterator_to(const_reference x) {
+			return const_iterator(iterator(const_cast<intrusive_slist_node*>(Hook::to_node(&x))));
+		}
+
+		//将 x 链接到 pos 之后，返回指向 x 的迭代器
+		iterator insert_after(iterator pos, reference x) {
+			intrusive_slist_node* node = Hook::to_node(&x);
+			node->next = pos.node->next;
+			pos.node->next = node;
+			++node_count;
+			return iterator(node);
+		}
+
+		//将 pos 之后的元素从链表中移除（不析构），返回下一个位置
+		iterator erase_after(iterator pos) {
+			intrusive_slist_node* node = pos.node->next;
+			pos.node->next = node->next;
+			node->next = 0;
+			--node_count;
+			return iterator(pos.node->next);
+		}
+
+		void push_front(reference x) { insert_after(before_begin(), x); }
+		void pop_front() { erase_after(before_begin()); }
+
+		//移除所有元素（不析构）
+		void clear() {
+			intrusive_slist_node* cur = dummyHead.next;
+			while (cur != 0) {
+				intrusive_slist_node* tmp = cur;
+				cur = cur->next;
+				tmp->next = 0;
+			}
+			dummyHead.next = 0;
+			node_count = 0;
+		}
+
+		//两个链表互换，只要将 dummyHead.next 交换互指即可
+		void swap(intrusive_slist& x) {
+			intrusive_slist_node* tmp = dummyHead.next;
+			dummyHead.next = x.dummyHead.next;
+			x.dummyHead.next = tmp;
+			size_type n = node_count;
+			node_count = x.node_count;
+			x.node_count = n;
+		}
+
+		/* 以下接合操作只调整指针 */
+		//将 x 的全部元素接合于 pos 之后，x 必须不同于 *this。需要找到 x 的尾节点，O(x.size())
+		void splice_after(iterator pos, intrusive_slist& x) {
+			if (x.empty() || &x == this)
+				return;
+			intrusive_slist_node* before_last = x.dummyHead.next;
+			while (before_last->next != 0)
+				before_last = before_last->next;
+			detail::__intrusive_slist_splice_after(pos.node, &x.dummyHead, before_last);
+			node_count += x.node_count;
+			x.node_count = 0;
+		}
+		//将 x 中 prev 之后的那一个元素接合于 pos 之后，x 可以就是 *this，O(1)
+		void splice_after(iterator pos, intrusive_slist& x, iterator prev) {
+			if (pos == prev || pos.node == prev.node->next)
+				return;
+			detail::__intrusive_slist_splice_after(pos.node, prev.node, prev.node->next);
+			++node_count;
+			--x.node_count;
+		}
+		//将 x 中 (before_first, before_last] 内的元素接合于 pos 之后，pos 不能位于该区间之内
+		void splice_after(iterator pos, intrusive_slist& x, iterator before_first, iterator before_last) {
+			if (before_first == before_last)
+				return;
+			if (&x != this) {
+				size_type n = 0;
+				for (intrusive_slist_node* cur = before_first.node; cur != before_last.node; cur = cur->next)
+					++n;
+				node_count += n;
+				x.node_count -= n;
+			}
+			detail::__intrusive_slist_splice_after(pos.node, before_first.node, before_last.node);
+		}
+
+		//将本链表的内容逆向重置
+		void reverse() {
+			intrusive_slist_node* result = 0;
+			intrusive_slist_node* node = dummyHead.next;
+			while (node) {
+				intrusive_slist_node* next = node->next;
+				node->next = result;
+				result = node;
+				node = next;
+			}
+			dummyHead.next = result;
+		}
+	};
+
+}// end of namespace lfp
+
+#endif // !_STL_INTRUSIVE_SLIST_H_
@@ -0,0 +1,517 @@
+/*
+ *unrolled_list实现，展开链表
+ *
+ *每个节点保存一小段连续的元素（缺省约一个 cache line，即 64 字节的元素），节点之间以双向循环链表相连。
+ *与 list 相比，每个元素分摊的链接指针开销和遍历时的 cache miss 都少得多；与 vector 相比，在中间插入、
+ *移除只需要移动一个节点内的元素
+ *
+ *节点的维护规则：除最后一个节点外，每个节点至少半满
+ *	插入时节点已满则对半分裂；移除后节点不足半满则与后一个节点合并，合并后放不下则从后一个节点借元素
+ *
+ *注意：插入、移除、接合操作会移动同一节点（以及相邻节点）内的元素，因此会使指向这些节点的迭代器失效
+ */
+
+#ifndef _STL_UNROLLED_LIST_H_
+#define _STL_UNROLLED_LIST_H_
+
+#include "1stl_alloctor.h"		//空间配置器
+#include "1stl_construct.h"		//对象构造与析构
+#include "1stl_iterator.h"		//for bidirectional_iterator_tag
+#include <cstddef>				//for ptrdiff_t size_t
+#include <type_traits>			//for aligned_storage
+
+namespace lfp {
+namespace detail {
+
+/* 辅助决定每个节点容纳的元素个数
+ * 如果 node_size 不为0，传回由用户定义的 node_size
+ * 如果 node_size 为0，表示使用默认值：一个节点容纳 64 字节的元素，但至少 4 个
+ */
+	template<size_t NodeSize, size_t ValSize>
+	struct __unrolled_node_capacity {
+		static const size_t value = (NodeSize != 0) ? NodeSize
+			: ((64 / ValSize >= 4) ? 64 / ValSize : 4);
+	};
+
+/* 以下是节点结构，header 只需要链接部分，因此采用双层结构 */
+	struct __unrolled_node_base {
+		__unrolled_node_base* prev;
+		__unrolled_node_base* next;
+		size_t count;		//节点内的元素个数，header 的 count 永远为0
+	};
+
+	template<class T, size_t N>
+	struct __unrolled_node : __unrolled_node_base {
+		typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type storage;		//未初始化的元素空间
+
+		T* data() { return reinterpret_cast<T*>(&storage); }
+	};
+
+/* 以下是 unrolled_list 迭代器设计，型别为双向迭代器，由节点和节点内的下标组成 */
+	template<class T, class Ref, class Ptr, size_t N>
+	struct __unrolled_list_iterator {
+		typedef __unrolled_list_iterator<T, Ref, Ptr, N>			self;
+		typedef __unrolled_list_iterator<T, T&, T*, N>				iterator;
+		typedef __unrolled_list_iterator<T, const T&, const T*, N>	const_iterator;
+		typedef bidirectional_iterator_tag		iterator_category;
+		typedef T								value_type;
+		typedef Ptr								pointer;
+		typedef Ref								reference;
+		typedef size_t							size_type;
+		typedef ptrdiff_t						difference_type;
+		typedef __unrolled_node<T, N>			node_type;
+
+		__unrolled_node_base* node;
+		size_t index;
+
+		__unrolled_list_iterator() : node(0), index(0) { }
+		__unrolled_list_iterator(__unrolled_node_base* x, size_t i) : node(x), index(i) { }
+		__unrolled_list_iterator(const iterator& x) : node(x.node), index(x.index) { }
+
+		bool operator==(const self& x) const { return node == x.node && index == x.index; }
+		bool operator!=(const self& x) const { return !(*this == x); }
+		reference operator*() const { return static_cast<node_type*>(node)->data()[index]; }
+		pointer operator->() const { return &(operator*()); }
+		//前进一个元素，走到节点末尾时跳到下一个节点的开头
+		self& operator++() {
+			if (++index == node->count) {
+				node = node->next;
+				index = 0;
+			}
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+		//后退一个元素，位于节点开头时跳到上一个节点的末尾
+		self& operator--() {
+			if (index == 0) {
+				node = node->prev;
+				index = node->count;
+			}
+			--index;
+			return *this;
+		}
+		self operator--(int) {
+			self tmp = *this;
+			--*this;
+			return tmp;
+		}
+	};
+
+}// end of namespace detail
+
+
+
+/*	以下是 unrolled_list 结构的实现	*/
+	template<class T, class Alloc = alloc, size_t NodeSize = 0>
+	struct unrolled_list {
+	public:
+		enum { N = detail::__unrolled_node_capacity<NodeSize, sizeof(T)>::value };	//每个节点容纳的元素个数
+
+		typedef T				value_type;
+		typedef T*				pointer;
+		typedef const T*		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef size_t			size_type;
+		typedef ptrdiff_t		difference_type;
+		typedef typename detail::__unrolled_list_iterator<T, T&, T*, N>::iterator			iterator;
+		typedef typename detail::__unrolled_list_iterator<T, T&, T*, N>::const_iterator		const_iterator;
+
+	protected:
+		typedef detail::__unrolled_node_base	base_node;
+		typedef detail::__unrolled_node<T, N>	node_type;
+
+		base_node header;		//尾端后面的空白节点。注意这是实体，首尾节点会指向它
+		size_type size_;
+
+		//专属空间配置器，每次配置一个节点大小
+		typedef simple_alloc<node_type, Alloc> node_allocator;
+
+		static T* elems(base_node* n) { return static_cast<node_type*>(n)->data(); }
+
+		//配置一个空节点并链接到 pos 之后
+		base_node* new_node_after(base_node* pos) {
+			node_type* n = node_allocator::allocate();
+			n->count = 0;
+			n->prev = pos;
+			n->next = pos->next;
+			pos->next->prev = n;
+			pos->next = n;
+			return n;
+		}
+		//将节点从链表中摘下并释放，其中的元素必须已经析构或移走
+		void free_node(base_node* n) {
+			n->prev->next = n->next;
+			n->next->prev = n->prev;
+			node_allocator::deallocate(static_cast<node_type*>(n));
+		}
+
+		//将 src 中 [from, count) 的元素移到 dst 的尾部，dst 必须放得下
+		//复制过程中抛出异常时撤销已复制的元素，两个节点都保持原状
+		static void move_back(base_node* dst, base_node* src, size_type from) {
+			T* d = elems(dst) + dst->count;
+			T* s = elems(src);
+			size_type i = from;
+			try {
+				for (; i < src->count; ++i)
+					construct(d + (i - from), s[i]);
+			}
+			catch (...) {
+				destroy(d, d + (i - from));
+				throw;
+			}
+			destroy(s + from, s + src->count);
+			dst->count += src->count - from;
+			src->count = from;
+		}
+
+		//在节点 n 的 i 处插入 x，节点必须未满
+		//末尾新构造的元素立即计入 count：其后移动元素的赋值抛出异常时，节点中的元素仍然都是完整的对象，
+		//只是多出一个重复的元素（没有元素丢失，也不会泄漏），由调用者相应地调整 size_
+		static void insert_into(base_node* n, size_type i, const T& x) {
+			T* p = elems(n);
+			size_type c = n->count;
+			if (i == c) {
+				construct(p + c, x);
+				++n->count;
+			}
+			else {
+				T x_copy = x;		//x 可能就是本节点内的元素
+				construct(p + c, p[c - 1]);
+				++n->count;
+				for (size_type j = c - 1; j > i; --j)
+					p[j] = p[j - 1];
+				p[i] = x_copy;
+			}
+		}
+
+		//移除节点 n 的 i 处的元素
+		static void erase_from(base_node* n, size_type i) {
+			T* p = elems(n);
+			size_type c = n->count;
+			for (size_type j = i; j + 1 < c; ++j)
+				p[j] = p[j + 1];
+			destroy(p + c - 1);
+			--n->count;
+		}
+
+		//将节点 n 对半分裂，[at, count) 移到新节点，返回新节点
+		base_node* split(base_node* n, size_type at) {
+			base_node* m = new_node_after(n);
+			try {
+				move_back(m, n, at);
+			}
+			catch (...) {
+				free_node(m);
+				throw;
+			}
+			return m;
+		}
+
+		//在 pos 处把节点切开，返回 pos 所指元素所在的节点（pos 为 end() 时返回 header）
+		base_node* split_at(iterator pos) {
+			if (pos.index == 0)
+				return pos.node;
+			return split(pos.node, pos.index);
+		}
+
+		//节点 n 不足半满且不是最后一个节点时，与后一个节点合并或从后一个节点借元素
+		//只会释放 n 的后一个节点，不会释放 n
+		void fix_node(base_node* n) {
+			base_node* next = n->next;
+			if (n == &header || next == &header || n->count >= N / 2)
+				return;
+			if (n->count + next->count <= N) {
+				move_back(n, next, 0);
+				free_node(next);
+			}
+			else {		//合并后放不下，从 next 开头借元素直到 n 半满，next 借出后仍然多于半满
+				size_type k = N / 2 - n->count;
+				T* src = elems(next);
+				T* dst = elems(n) + n->count;
+				size_type i = 0;
+				try {
+					for (; i < k; ++i)
+						construct(dst + i, src[i]);
+				}
+				catch (...) {
+					destroy(dst, dst + i);
+					throw;
+				}
+				n->count += k;
+				for (size_type j = 0; j + k < next->count; ++j)
+					src[j] = src[j + k];
+				destroy(src + next->count - k, src + next->count);
+				next->count -= k;
+			}
+		}
+
+		//计算 pos 之前的元素个数，以及由此找回迭代器。用于同一链表内的接合
+		size_type rank(iterator pos) {
+			size_type r = 0;
+			for (base_node* n = header.next; n != pos.node; n = n->next)
+				r += n->count;
+			return r + pos.index;
+		}
+		iterator iterator_at(size_type r) {
+			base_node* n = header.next;
+			while (n != &header && r >= n->count) {
+				r -= n->count;
+				n = n->next;
+			}
+			return iterator(n, r);
+		}
+
+	public:
+		unrolled_list() : size_(0) {
+			header.next = &header;
+			header.prev = &header;
+			header.count = 0;
+		}
+		unrolled_list(const unrolled_list& x) : size_(0) {
+			header.next = &header;
+			header.prev = &header;
+			header.count = 0;
+			try {
+				for (const_iterator it = x.begin(); it != x.end(); ++it)
+					push_back(*it);
+			}
+			catch (...) {
+				clear();
+				throw;
+			}
+		}
+		unrolled_list& operator=(const unrolled_list& x) {
+			if (&x != this) {
+				clear();
+				for (const_iterator it = x.begin(); it != x.end(); ++it)
+					push_back(*it);
+			}
+			return *this;
+		}
+		~unrolled_list() { clear(); }
+
+		iterator begin() { return iterator(header.next, 0); }
+		const_iterator begin() const { return iterator(header.next, 0); }
+		iterator end() { return iterator(&header, 0); }
+		const_iterator end() const { return iterator(const_cast<base_node*>(&header), 0); }
+		bool empty() const { return size_ == 0; }
+		size_type size() const { return size_; }
+
+		reference front() { return *begin(); }
+		const_reference front() const { return *begin(); }
+		reference back() { return *(--end()); }
+		const_reference back() const { return *(--end()); }
+
+		//在迭代器 pos 所指位置插入 x，返回指向新元素的迭代器
+		iterator insert(iterator pos, const T& x);
+
+		//移除迭代器 pos 所指元素，返回指向下一个元素的迭代器
+		iterator erase(iterator pos);
+		iterator erase(iterator first, iterator last) {
+			//按节点累加 [first, last) 的元素个数，只走过区间所跨的节点
+			size_type n = last.index - first.index;
+			for (base_node* p = first.node; p != last.node; p = p->next)
+				n += p->count;
+			iterator it = first;
+			while (n-- > 0)		//每次移除后迭代器可能失效，因此使用 erase 的返回值
+				it = erase(it);
+			return it;
+		}
+
+		void push_front(const T& x) { insert(begin(), x); }
+		void push_back(const T& x) { insert(end(), x); }
+		void pop_front() { erase(begin()); }
+		void pop_back() { erase(--end()); }
+
+		//清空整个链表
+		void clear();
+
+		//交换两个链表的内容。由于首尾节点指向各自的 header，需要修正它们的指针
+		void swap(unrolled_list& x);
+
+		/* 以下接合操作只重新链接整个节点，最多在接合处切开节点、移动切口处的元素 */
+		//将 x 的全部元素接合于 pos 之前，x 必须不同于 *this
+		void splice(iterator pos, unrolled_list& x) {
+			if (!x.empty())
+				splice(pos, x, x.begin(), x.end());
+		}
+		//将 x 中 i 所指的元素接合于 pos 之前，x 可以就是 *this
+		void splice(iterator pos, unrolled_list& x, iterator i) {
+			iterator j = i;
+			++j;
+			if (pos == i || pos == j)
+				return;
+			splice(pos, x, i, j);
+		}
+		//将 x 中 [first, last) 内的元素接合于 pos 之前，x 可以就是 *this，但 pos 不能位于该区间之内
+		void splice(iterator pos, unrolled_list& x, iterator first, iterator last);
+	};
+
+
+
+	//在迭代器 pos 所指位置插入 x
+	template<class T, class Alloc, size_t NodeSize>
+	typename unrolled_list<T, Alloc, NodeSize>::iterator
+		unrolled_list<T, Alloc, NodeSize>::insert(iterator pos, const T& x) {
+		base_node* n = pos.node;
+		size_type i = pos.index;
+
+		if (n == &header) {		//在尾端插入：追加到最后一个节点，已满则配置一个新节点
+			n = header.prev;
+			if (n == &header || n->count == N)
+				n = new_node_after(header.prev);
+			i = n->count;
+		}
+		else if (i == 0 && n->prev != &header && n->prev->count < N) {
+			n = n->prev;		//在节点开头插入时，优先追加到前一个节点的尾部，不需要移动元素
+			i = n->count;
+		}
+
+		if (n->count == N) {		//节点已满则对半分裂，再插入到相应的一半
+			base_node* m = split(n, N / 2);
+			if (i > N / 2) {
+				n = m;
+				i -= N / 2;
+			}
+		}
+
+		size_type old_count = n->count;
+		try {
+			insert_into(n, i, x);
+		}
+		catch (...) {
+			size_ += n->count - old_count;		//移动元素时失败，节点中已多出一个元素
+			if (n->count == 0)		//新配置的节点，插入失败时释放
+				free_node(n);
+			throw;
+		}
+		++size_;
+		return iterator(n, i);
+	}
+
+	//移除迭代器 pos 所指元素
+	template<class T, class Alloc, size_t NodeSize>
+	typename unrolled_list<T, Alloc, NodeSize>::iterator
+		unrolled_list<T, Alloc, NodeSize>::erase(iterator pos) {
+		base_node* n = pos.node;
+		size_type i = pos.index;
+		erase_from(n, i);
+		--size_;
+
+		if (n->count == 0) {		//节点已空则释放
+			base_node* next = n->next;
+			free_node(n);
+			return iterator(next, 0);
+		}
+		fix_node(n);		//不足半满则与后一个节点合并或借元素，n 中 [0, i) 的元素不受影响
+		if (i == n->count)
+			return iterator(n->next, 0);
+		return iterator(n, i);
+	}
+
+	//清空整个链表
+	template<class T, class Alloc, size_t NodeSize>
+	void unrolled_list<T, Alloc, NodeSize>::clear() {
+		base_node* cur = header.next;
+		while (cur != &header) {
+			base_node* tmp = cur;
+			cur = cur->next;
+			destroy(elems(tmp), elems(tmp) + tmp->count);
+			node_allocator::deallocate(static_cast<node_type*>(tmp));
+		}
+		header.next = &header;
+		header.prev = &header;
+		size_ = 0;
+	}
+
+	//交换两个链表的内容
+	template<class T, class Alloc, size_t NodeSize>
+	void unrolled_list<T, Alloc, NodeSize>::swap(unrolled_list& x) {
+		base_node* next = header.next;
+		base_node* prev = header.prev;
+		header.next = x.header.next;
+		header.prev = x.header.prev;
+		x.header.next = next;
+		x.header.prev = prev;
+
+		if (header.next == &x.header) {		//x 原本为空
+			header.next = &header;
+			header.prev = &header;
+		}
+		else {
+			header.next->prev = &header;
+			header.prev->next = &header;
+		}
+		if (x.header.next == &header) {		//*this 原本为空
+			x.header.next = &x.header;
+			x.header.prev = &x.header;
+		}
+		else {
+			x.header.next->prev = &x.header;
+			x.header.prev->next = &x.header;
+		}
+
+		size_type n = size_;
+		size_ = x.size_;
+		x.size_ = n;
+	}
+
+	//将 x 中 [first, last) 内的元素接合于 pos 之前
+	template<class T, class Alloc, size_t NodeSize>
+	void unrolled_list<T, Alloc, NodeSize>::splice(iterator pos, unrolled_list& x, iterator first, iterator last) {
+		if (first == last)
+			return;
+
+		//同一链表内接合时，切开节点会使 pos 失效，因此先记下 pos 之前（不含被移走部分）的元素个数
+		bool same = (&x == this);
+		size_type pos_rank = 0;
+		if (same) {
+			pos_rank = rank(pos);
+			size_type first_rank = rank(first);
+			if (pos_rank > first_rank)
+				pos_rank -= rank(last) - first_rank;
+		}
+
+		//1. 在 x 中把 [first, last) 切成若干完整的节点。先切 last，first 仍然有效
+		base_node* last_node = x.split_at(last);
+		base_node* first_node = x.split_at(first);
+		base_node* chain_last = last_node->prev;
+
+		//2. 摘下 [first_node, last_node) 这一串节点
+		size_type n = 0;
+		for (base_node* cur = first_node; cur != last_node; cur = cur->next)
+			n += cur->count;
+		base_node* x_prev = first_node->prev;
+		x_prev->next = last_node;
+		last_node->prev = x_prev;
+		x.size_ -= n;
+		x.fix_node(last_node);
+		x.fix_node(x_prev);
+
+		//3. 在 pos 处切开，把这一串节点链接进来
+		if (same)
+			pos = iterator_at(pos_rank);
+		base_node* at = split_at(pos);
+		base_node* left = at->prev;
+		left->next = first_node;
+		first_node->prev = left;
+		chain_last->next = at;
+		at->prev = chain_last;
+		size_ += n;
+
+		//4. 修正接合处可能不足半满的节点。fix_node 只会释放其后一个节点，因此从右向左处理
+		fix_node(at);
+		fix_node(chain_last);
+		if (first_node != chain_last)
+			fix_node(first_node);
+		fix_node(left);
+	}
+
+}// end of namespace lfp
+
+#endif // !_STL_UNROLLED_LIST_H_
@@ -0,0 +1,287 @@
+/*
+ *circular_buffer实现，定长环形缓冲区
+ *
+ *全部元素存放在一块连续空间之中，容量总是 2 的幂，下标回绕只需一次掩码运算。
+ *缓冲区已满时的行为由构造时指定的策略决定：
+ *	circular_buffer_overwrite	覆盖最旧的元素（缺省）
+ *	circular_buffer_reject		拒绝新元素，push_back 返回 false
+ *元素在空间中最多分为两段连续区间，array_one()、array_two() 传回这两段，便于批量读写（例如直接交给 write/memcpy）
+ *
+ *提供 push_back、pop_front、front、back、empty、size，可以作为 queue 的底层容器：
+ *	queue<int, circular_buffer<int> > q(circular_buffer<int>(1024, circular_buffer_reject));
+ *缺省构造的缓冲区在第一次 push_back 时配置 16 个元素的空间，因此 queue<int, circular_buffer<int> > q; 也可以直接使用
+ */
+
+#ifndef _STL_CIRCULAR_BUFFER_H_
+#define _STL_CIRCULAR_BUFFER_H_
+
+#include "1stl_alloctor.h"		//空间配置器
+#include "1stl_construct.h"		//对象构造与析构
+#include "1stl_iterator.h"		//for random_access_iterator_tag
+#include "2stl_algobase.h"		//for swap
+#include <cstddef>				//for ptrdiff_t size_t
+#include <utility>				//for pair
+
+namespace lfp {
+
+	//缓冲区已满时的策略
+	enum circular_buffer_policy {
+		circular_buffer_overwrite,		//覆盖最旧的元素
+		circular_buffer_reject			//拒绝新元素
+	};
+
+namespace detail {
+
+	//缺省构造的缓冲区第一次加入元素时配置的容量
+	const size_t __circular_buffer_default_capacity = 16;
+
+	//将 n 向上取整为 2 的幂，n 为0时传回0
+	inline size_t __circular_buffer_round_up(size_t n) {
+		if (n == 0)
+			return 0;
+		size_t cap = 1;
+		while (cap < n)
+			cap <<= 1;
+		return cap;
+	}
+
+/* 以下是 circular_buffer 迭代器设计，型别为随机访问迭代器
+ * index 是不取模的逻辑位置（从 head 开始递增，允许溢出回绕），提领时才与 mask 做掩码，
+ * 因此迭代器之间的距离、比较都直接由 index 得出
+ */
+	template<class T, class Ref, class Ptr>
+	struct __circular_buffer_iterator {
+		typedef __circular_buffer_iterator<T, Ref, Ptr>				self;
+		typedef __circular_buffer_iterator<T, T&, T*>				iterator;
+		typedef __circular_buffer_iterator<T, const T&, const T*>	const_iterator;
+		typedef random_access_iterator_tag		iterator_category;
+		typedef T								value_type;
+		typedef Ptr								pointer;
+		typedef Ref								reference;
+		typedef size_t							size_type;
+		typedef ptrdiff_t						difference_type;
+
+		T* buf;
+		size_type mask;
+		size_type index;
+
+		__circular_buffer_iterator() : buf(0), mask(0), index(0) { }
+		__circular_buffer_iterator(T* b, size_type m, size_type i) : buf(b), mask(m), index(i) { }
+		__circular_buffer_iterator(const iterator& x) : buf(x.buf), mask(x.mask), index(x.index) { }
+
+		reference operator*() const { return buf[index & mask]; }
+		pointer operator->() const { return &(operator*()); }
+		reference operator[](difference_type n) const { return buf[(index + n) & mask]; }
+
+		self& operator++() { ++index; return *this; }
+		self operator++(int) { self tmp = *this; ++index; return tmp; }
+		self& operator--() { --index; return *this; }
+		self operator--(int) { self tmp = *this; --index; return tmp; }
+		self& operator+=(difference_type n) { index += n; return *this; }
+		self& operator-=(difference_type n) { index -= n; return *this; }
+		self operator+(difference_type n) const { return self(buf, mask, index + n); }
+		self operator-(difference_type n) const { return self(buf, mask, index - n); }
+		difference_type operator-(const self& x) const { return difference_type(index - x.index); }
+
+		bool operator==(const self& x) const { return index == x.index; }
+		bool operator!=(const self& x) const { return index != x.index; }
+		bool operator<(const self& x) const { return difference_type(index - x.index) < 0; }
+		bool operator>(const self& x) const { return x < *this; }
+		bool operator<=(const self& x) const { return !(x < *this); }
+		bool operator>=(const self& x) const { return !(*this < x); }
+	};
+
+}// end of namespace detail
+
+
+
+/* 以下是 circular_buffer 结构的实现 */
+	template<class T, class Alloc = alloc>
+	class circular_buffer {
+	public:
+		typedef T					value_type;
+		typedef T*					pointer;
+		typedef const T*			const_pointer;
+		typedef T&					reference;
+		typedef const T&			const_reference;
+		typedef size_t				size_type;
+		typedef ptrdiff_t			difference_type;
+		typedef typename detail::__circular_buffer_iterator<T, T&, T*>::iterator			iterator;
+		typedef typename detail::__circular_buffer_iterator<T, T&, T*>::const_iterator		const_iterator;
+		typedef std::pair<pointer, size_type>				array_range;		//一段连续区间：起点与元素个数
+		typedef std::pair<const_pointer, size_type>			const_array_range;
+
+	private:
+		typedef simple_alloc<value_type, Alloc> data_allocator;
+
+		pointer buf;				//连续空间的起点
+		size_type cap;				//容量，总是 2 的幂（或0）
+		size_type head;				//第一个元素在空间中的下标
+		size_type count;			//元素个数
+		circular_buffer_policy policy;
+
+		size_type mask() const { return cap - 1; }
+		//第 n 个元素在空间中的下标
+		size_type slot(size_type n) const { return (head + n) & mask(); }
+
+		//在已配置的空白空间中，由 [first, first + n) 复制出元素，从下标0开始存放
+		template<class Iterator>
+		void copy_initialize(Iterator first, size_type n) {
+			size_type i = 0;
+			try {
+				for (; i < n; ++i, ++first)
+					construct(buf + i, *first);
+			}
+			catch (...) {
+				destroy(buf, buf + i);
+				throw;
+			}
+			count = n;
+		}
+
+	public:
+		//缺省构造的缓冲区容量为0，不配置空间；第一次 push_back 时容量扩充为 __circular_buffer_default_capacity，
+		//也可以先以 set_capacity 指定容量
+		explicit circular_buffer(circular_buffer_policy p = circular_buffer_overwrite)
+			: buf(0), cap(0), head(0), count(0), policy(p) { }
+		//容量为不小于 n 的 2 的幂
+		explicit circular_buffer(size_type n, circular_buffer_policy p = circular_buffer_overwrite)
+			: buf(0), cap(detail::__circular_buffer_round_up(n)), head(0), count(0), policy(p) {
+			if (cap)
+				buf = data_allocator::allocate(cap);
+		}
+		circular_buffer(const circular_buffer& x)
+			: buf(0), cap(x.cap), head(0), count(0), policy(x.policy) {
+			if (cap == 0)
+				return;
+			buf = data_allocator::allocate(cap);
+			try {
+				copy_initialize(x.begin(), x.count);
+			}
+			catch (...) {
+				data_allocator::deallocate(buf, cap);
+				throw;
+			}
+		}
+		circular_buffer& operator=(const circular_buffer& x) {
+			if (this != &x) {
+				circular_buffer tmp(x);
+				swap(tmp);
+			}
+			return *this;
+		}
+		~circular_buffer() {
+			clear();
+			if (buf)
+				data_allocator::deallocate(buf, cap);
+		}
+
+		iterator begin() { return iterator(buf, mask(), head); }
+		const_iterator begin() const { return const_iterator(iterator(buf, mask(), head)); }
+		iterator end() { return iterator(buf, mask(), head + count); }
+		const_iterator end() const { return const_iterator(iterator(buf, mask(), head + count)); }
+
+		bool empty() const { return count == 0; }
+		bool full() const { return count == cap; }
+		size_type size() const { return count; }
+		size_type capacity() const { return cap; }
+		size_type max_size() const { return size_type(-1) / sizeof(T); }
+		circular_buffer_policy overflow_policy() const { return policy; }
+
+		reference operator[](size_type n) { return buf[slot(n)]; }
+		const_reference operator[](size_type n) const { return buf[slot(n)]; }
+		reference front() { return buf[head]; }
+		const_reference front() const { return buf[head]; }
+		reference back() { return buf[slot(count - 1)]; }
+		const_reference back() const { return buf[slot(count - 1)]; }
+
+		//在尾端加入 x。缓冲区已满时按策略覆盖最旧的元素或拒绝，被拒绝时返回 false
+		bool push_back(const value_type& x) {
+			if (cap == 0)
+				set_capacity(detail::__circular_buffer_default_capacity);
+			if (count != cap) {
+				construct(buf + slot(count), x);
+				++count;
+				return true;
+			}
+			if (policy == circular_buffer_reject)
+				return false;
+			buf[head] = x;		//覆盖最旧的元素，它随即成为最新的元素
+			head = (head + 1) & mask();
+			return true;
+		}
+
+		//将 [first, last) 依次加入尾端，返回被接受的元素个数
+		template<class InputIterator>
+		size_type push_back(InputIterator first, InputIterator last) {
+			size_type n = 0;
+			for (; first != last; ++first) {
+				if (!push_back(*first))
+					break;
+				++n;
+			}
+			return n;
+		}
+
+		void pop_front() {
+			destroy(buf + head);
+			head = (head + 1) & mask();
+			--count;
+		}
+		//移除最前端的 n 个元素，n 不得大于 size()。通常在处理完 array_one()/array_two() 之后调用
+		void pop_front(size_type n) {
+			for (; n != 0; --n)
+				pop_front();
+		}
+		void pop_back() {
+			--count;
+			destroy(buf + slot(count));
+		}
+
+		void clear() {
+			pop_front(count);
+			head = 0;
+		}
+
+		/* 两段连续区间：元素依次为 array_one() 的全部，再接 array_two() 的全部 */
+		array_range array_one() {
+			size_type n = (head + count <= cap) ? count : cap - head;
+			return array_range(buf + head, n);
+		}
+		const_array_range array_one() const {
+			size_type n = (head + count <= cap) ? count : cap - head;
+			return const_array_range(buf + head, n);
+		}
+		array_range array_two() {
+			size_type n = (head + count <= cap) ? 0 : head + count - cap;
+			return array_range(buf, n);
+		}
+		const_array_range array_two() const {
+			size_type n = (head + count <= cap) ? 0 : head + count - cap;
+			return const_array_range(buf, n);
+		}
+
+		//重新指定容量（向上取整为 2 的幂）。元素多于新容量时保留最新的那些
+		void set_capacity(size_type n) {
+			n = detail::__circular_buffer_round_up(n);
+			if (n == cap)
+				return;
+			size_type keep = (count < n) ? count : n;
+			pop_front(count - keep);
+			circular_buffer tmp(n, policy);
+			tmp.copy_initialize(begin(), keep);
+			swap(tmp);
+		}
+
+		void swap(circular_buffer& x) {
+			lfp::swap(buf, x.buf);
+			lfp::swap(cap, x.cap);
+			lfp::swap(head, x.head);
+			lfp::swap(count, x.count);
+			lfp::swap(policy, x.policy);
+		}
+	};
+
+}// end of namespace lfp
+
+#endif // !_STL_CIRCULAR_BUFFER_H_
@@ -0,0 +1,190 @@
+/*
+ *mpmc_queue实现，有界无锁多生产者多消费者队列
+ *
+ *容量为 2 的幂的环形数组，每个槽位带有一个序号（Dmitry Vyukov 的做法）：
+ *	槽位 i 的序号等于 pos 时表示位置 pos 可以写入，等于 pos + 1 时表示位置 pos 的元素可以读出，
+ *	读出后序号改为 pos + capacity，即下一轮的写入位置
+ *生产者以 CAS 推进 tail 抢占位置，消费者以 CAS 推进 head 抢占位置，彼此只在同一个槽位上同步。
+ *head 与 tail 各自独占一条 cache line，避免生产者与消费者之间的伪共享
+ *
+ *队列满时 try_push 返回 false，队列空时 try_pop 返回 false，都不会阻塞。
+ *注意：元素的复制构造与赋值不得抛出异常；队列对象本身不可复制
+ */
+
+#ifndef _STL_MPMC_QUEUE_H_
+#define _STL_MPMC_QUEUE_H_
+
+#include "1stl_alloctor.h"		//空间配置器
+#include "1stl_construct.h"		//对象构造与析构
+#include <atomic>
+#include <cstddef>				//for size_t
+#include <new>					//for placement new
+#include <type_traits>			//for aligned_storage
+
+namespace lfp {
+namespace detail {
+
+	enum { __cache_line_size = 64 };		//用于填充，使被不同线程频繁写入的数据位于不同的 cache line
+
+	//将 n 向上取整为 2 的幂，至少为 2
+	inline size_t __mpmc_round_up(size_t n) {
+		size_t cap = 2;
+		while (cap < n)
+			cap <<= 1;
+		return cap;
+	}
+
+	//槽位：序号与未初始化的元素空间
+	template<class T>
+	struct __mpmc_cell {
+		std::atomic<size_t> sequence;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+		T* value() { return reinterpret_cast<T*>(&storage); }
+	};
+
+}// end of namespace detail
+
+
+
+	template<class T, class Alloc = alloc>
+	class mpmc_queue {
+	public:
+		typedef T			value_type;
+		typedef size_t		size_type;
+
+	private:
+		typedef detail::__mpmc_cell<T> cell_type;
+		typedef simple_alloc<cell_type, Alloc> cell_allocator;
+
+		char pad0[detail::__cache_line_size];
+		cell_type* const buffer;
+		const size_type mask;
+		char pad1[detail::__cache_line_size - sizeof(cell_type*) - sizeof(size_type)];
+		std::atomic<size_type> tail;		//下一个写入位置，由生产者推进
+		char pad2[detail::__cache_line_size - sizeof(std::atomic<size_type>)];
+		std::atomic<size_type> head;		//下一个读出位置，由消费者推进
+		char pad3[detail::__cache_line_size - sizeof(std::atomic<size_type>)];
+
+		mpmc_queue(const mpmc_queue&);
+		mpmc_queue& operator=(const mpmc_queue&);
+
+		/* 抢占从 tail 开始、最多 n 个连续的可写位置，传回抢到的个数，起始位置存入 pos */
+		size_type claim_push(size_type n, size_type& pos) {
+			pos = tail.load(std::memory_order_relaxed);
+			for (;;) {
+				size_type k = 0;
+				while (k < n && buffer[(pos + k) & mask].sequence.load(std::memory_order_acquire) == pos + k)
+					++k;
+				if (k == 0) {
+					size_type seq = buffer[pos & mask].sequence.load(std::memory_order_acquire);
+					if (ptrdiff_t(seq - pos) < 0)
+						return 0;		//该位置上一轮的元素尚未被读出，队列已满
+					pos = tail.load(std::memory_order_relaxed);		//位置已被其他生产者抢走
+					continue;
+				}
+				if (tail.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+					return k;
+				//CAS 失败时 pos 已更新为当前的 tail，重新检查
+			}
+		}
+
+		/* 抢占从 head 开始、最多 n 个连续的可读位置，传回抢到的个数，起始位置存入 pos */
+		size_type claim_pop(size_type n, size_type& pos) {
+			pos = head.load(std::memory_order_relaxed);
+			for (;;) {
+				size_type k = 0;
+				while (k < n && buffer[(pos + k) & mask].sequence.load(std::memory_order_acquire) == pos + k + 1)
+					++k;
+				if (k == 0) {
+					size_type seq = buffer[pos & mask].sequence.load(std::memory_order_acquire);
+					if (ptrdiff_t(seq - (pos + 1)) < 0)
+						return 0;		//该位置尚未写入元素，队列为空
+					pos = head.load(std::memory_order_relaxed);		//位置已被其他消费者抢走
+					continue;
+				}
+				if (head.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+					return k;
+			}
+		}
+
+		//在已抢占的位置 pos 上构造元素并发布给消费者
+		void publish(size_type pos, const value_type& x) {
+			cell_type& cell = buffer[pos & mask];
+			construct(cell.value(), x);
+			cell.sequence.store(pos + 1, std::memory_order_release);
+		}
+		//从已抢占的位置 pos 上取出元素，并将槽位交还给下一轮的生产者
+		void consume(size_type pos, value_type& x) {
+			cell_type& cell = buffer[pos & mask];
+			x = *cell.value();
+			destroy(cell.value());
+			cell.sequence.store(pos + mask + 1, std::memory_order_release);
+		}
+
+	public:
+		//容量为不小于 n 的 2 的幂
+		explicit mpmc_queue(size_type n)
+			: buffer(cell_allocator::allocate(detail::__mpmc_round_up(n))),
+			  mask(detail::__mpmc_round_up(n) - 1), tail(0), head(0) {
+			for (size_type i = 0; i <= mask; ++i)
+				new (&buffer[i].sequence) std::atomic<size_type>(i);
+		}
+		//析构时队列不得再被其他线程使用
+		~mpmc_queue() {
+			size_type t = tail.load(std::memory_order_relaxed);
+			for (size_type pos = head.load(std::memory_order_relaxed); pos != t; ++pos)
+				destroy(buffer[pos & mask].value());
+			cell_allocator::deallocate(buffer, mask + 1);
+		}
+
+		size_type capacity() const { return mask + 1; }
+		//元素个数的近似值，其他线程同时操作时仅供参考
+		size_type size_approx() const {
+			size_type t = tail.load(std::memory_order_relaxed);
+			size_type h = head.load(std::memory_order_relaxed);
+			return ptrdiff_t(t - h) > 0 ? t - h : 0;
+		}
+		bool empty_approx() const { return size_approx() == 0; }
+
+		//加入一个元素，队列满时返回 false
+		bool try_push(const value_type& x) {
+			size_type pos;
+			if (claim_push(1, pos) == 0)
+				return false;
+			publish(pos, x);
+			return true;
+		}
+		//取出一个元素存入 x，队列空时返回 false
+		bool try_pop(value_type& x) {
+			size_type pos;
+			if (claim_pop(1, pos) == 0)
+				return false;
+			consume(pos, x);
+			return true;
+		}
+
+		/* 批量操作：一次 CAS 抢占一段连续位置，减少对 head/tail 的争用 */
+		//加入 [first, first + n) 的前若干个元素，传回实际加入的个数（队列满时可能少于 n）
+		template<class InputIterator>
+		size_type try_push_n(InputIterator first, size_type n) {
+			size_type pos;
+			size_type k = claim_push(n, pos);
+			for (size_type i = 0; i < k; ++i, ++first)
+				publish(pos + i, *first);
+			return k;
+		}
+		//最多取出 n 个元素依次赋值给 *result，传回实际取出的个数
+		template<class OutputIterator>
+		size_type try_pop_n(OutputIterator result, size_type n) {
+			size_type pos;
+			size_type k = claim_pop(n, pos);
+			for (size_type i = 0; i < k; ++i, ++result)
+				consume(pos + i, *result);
+			return k;
+		}
+	};
+
+}// end of namespace lfp
+
+#endif // !_STL_MPMC_QUEUE_H_
@@ -0,0 +1,157 @@
+/*
+ *spsc_queue实现，有界无等待单生产者单消费者队列
+ *
+ *只允许一个线程写入、一个线程读出。容量为 2 的幂的环形数组，tail 只由生产者写，head 只由消费者写，
+ *两边都不需要 CAS，每个操作的步数都有上界（wait-free）
+ *
+ *生产者与消费者各自缓存一份对方的下标（head_cache、tail_cache），只有按缓存判断为满或空时才去读取对方的原子变量，
+ *从而大多数操作不会触及对方所在的 cache line。生产者的数据、消费者的数据各自独占 cache line，避免伪共享
+ *
+ *front() 直接传回队头元素的指针而不复制，处理完后调用 pop() 将其移除；push_n、pop_n 一次发布或回收一批元素
+ *注意：队列对象本身不可复制
+ */
+
+#ifndef _STL_SPSC_QUEUE_H_
+#define _STL_SPSC_QUEUE_H_
+
+#include "1stl_alloctor.h"		//空间配置器
+#include "1stl_construct.h"		//对象构造与析构
+#include "28stl_mpmc_queue.h"	//for __cache_line_size __mpmc_round_up
+#include <atomic>
+#include <cstddef>				//for size_t
+
+namespace lfp {
+
+	template<class T, class Alloc = alloc>
+	class spsc_queue {
+	public:
+		typedef T			value_type;
+		typedef T*			pointer;
+		typedef T&			reference;
+		typedef size_t		size_type;
+
+	private:
+		typedef simple_alloc<value_type, Alloc> data_allocator;
+
+		char pad0[detail::__cache_line_size];
+		pointer const buffer;
+		const size_type mask;
+		char pad1[detail::__cache_line_size - sizeof(pointer) - sizeof(size_type)];
+
+		/* 生产者独占的数据 */
+		std::atomic<size_type> tail;		//下一个写入位置
+		size_type head_cache;				//生产者最近一次读到的 head
+		char pad2[detail::__cache_line_size - sizeof(std::atomic<size_type>) - sizeof(size_type)];
+
+		/* 消费者独占的数据 */
+		std::atomic<size_type> head;		//下一个读出位置
+		size_type tail_cache;				//消费者最近一次读到的 tail
+		char pad3[detail::__cache_line_size - sizeof(std::atomic<size_type>) - sizeof(size_type)];
+
+		spsc_queue(const spsc_queue&);
+		spsc_queue& operator=(const spsc_queue&);
+
+		//生产者调用：从位置 t 开始可以写入的元素个数，不足 n 个时才重新读取 head
+		size_type free_slots(size_type t, size_type n) {
+			size_type room = mask + 1 - (t - head_cache);
+			if (room < n) {
+				head_cache = head.load(std::memory_order_acquire);
+				room = mask + 1 - (t - head_cache);
+			}
+			return room;
+		}
+		//消费者调用：从位置 h 开始可以读出的元素个数，不足 n 个时才重新读取 tail
+		size_type ready_slots(size_type h, size_type n) {
+			size_type avail = tail_cache - h;
+			if (avail < n) {
+				tail_cache = tail.load(std::memory_order_acquire);
+				avail = tail_cache - h;
+			}
+			return avail;
+		}
+
+	public:
+		//容量为不小于 n 的 2 的幂
+		explicit spsc_queue(size_type n)
+			: buffer(data_allocator::allocate(detail::__mpmc_round_up(n))),
+			  mask(detail::__mpmc_round_up(n) - 1), tail(0), head_cache(0), head(0), tail_cache(0) { }
+		//析构时队列不得再被其他线程使用
+		~spsc_queue() {
+			size_type t = tail.load(std::memory_order_relaxed);
+			for (size_type pos = head.load(std::memory_order_relaxed); pos != t; ++pos)
+				destroy(buffer + (pos & mask));
+			data_allocator::deallocate(buffer, mask + 1);
+		}
+
+		size_type capacity() const { return mask + 1; }
+		//元素个数的近似值，另一端同时操作时仅供参考
+		size_type size_approx() const {
+			return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+		}
+
+		/* 以下由生产者调用 */
+		//加入一个元素，队列满时返回 false
+		bool try_push(const value_type& x) {
+			size_type t = tail.load(std::memory_order_relaxed);
+			if (free_slots(t, 1) == 0)
+				return false;
+			construct(buffer + (t & mask), x);
+			tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+		//加入 [first, first + n) 的前若干个元素，一次发布，传回实际加入的个数
+		template<class InputIterator>
+		size_type push_n(InputIterator first, size_type n) {
+			size_type t = tail.load(std::memory_order_relaxed);
+			size_type room = free_slots(t, n);
+			if (n > room)
+				n = room;
+			for (size_type i = 0; i < n; ++i, ++first)
+				construct(buffer + ((t + i) & mask), *first);
+			tail.store(t + n, std::memory_order_release);
+			return n;
+		}
+
+		/* 以下由消费者调用 */
+		//队头元素的指针，队列空时传回空指针。元素仍在队列之中，直到调用 pop()
+		pointer front() {
+			size_type h = head.load(std::memory_order_relaxed);
+			if (ready_slots(h, 1) == 0)
+				return 0;
+			return buffer + (h & mask);
+		}
+		//移除队头元素，只能在 front() 传回非空指针之后调用
+		void pop() {
+			size_type h = head.load(std::memory_order_relaxed);
+			destroy(buffer + (h & mask));
+			head.store(h + 1, std::memory_order_release);
+		}
+		//取出队头元素存入 x，队列空时返回 false
+		bool try_pop(value_type& x) {
+			pointer p = front();
+			if (p == 0)
+				return false;
+			x = *p;
+			pop();
+			return true;
+		}
+		//最多取出 n 个元素依次赋值给 *result，一次回收，传回实际取出的个数
+		template<class OutputIterator>
+		size_type pop_n(OutputIterator result, size_type n) {
+			size_type h = head.load(std::memory_order_relaxed);
+			size_type avail = ready_slots(h, n);
+			if (n > avail)
+				n = avail;
+			for (size_type i = 0; i < n; ++i, ++result) {
+				pointer p = buffer + ((h + i) & mask);
+				*result = *p;
+				destroy(p);
+			}
+			head.store(h + n, std::memory_order_release);
+			return n;
+		}
+	};
+
+}// end of namespace lfp
+
+#endif // !_STL_SPSC_QUEUE_H_
@@ -57,6 +57,14 @@ namespace lfp {		//这一级namespace下是外部用户使用的标注接口
 		return first;
 	}
 
+/* for_each: 对 [first, last) 内的每个元素调用 f，返回 f */
+	template<class InputIterator, class Function>
+	inline Function for_each(InputIterator first, InputIterator last, Function f) {
+		for (; first != last; ++first)
+			f(*first);
+		return f;
+	}
+
 
 namespace detail {		//这一级namespace下是stl下内部实现细节
 
@@ -539,6 +547,14 @@ namespace detail {		//这一级namespace下是stl下内部实现细节
 	};
 
 
+/* 构造有序容器时表明输入区间已排序，容器据此直接建立而不再逐个插入：
+   sorted_unique 表示严格递增（没有重复的键值），sorted_equivalent 表示非递减 */
+	struct sorted_unique_t { };
+	struct sorted_equivalent_t { };
+	const sorted_unique_t sorted_unique = sorted_unique_t();
+	const sorted_equivalent_t sorted_equivalent = sorted_equivalent_t();
+
+
 /* 证同(identity)、选择(select)、投射(project)函数 */
 	template<class T>
 	struct identity : public unary_function<T, T> {
@@ -593,4 +609,4 @@ namespace detail {		//这一级namespace下是stl下内部实现细节
 
 }// end of namespace lfp
 
-#endif // !_STL_ALGOBASE_H_
\ No newline at end of file
+#endif // !_STL_ALGOBASE_H_
\ No newline at end of file
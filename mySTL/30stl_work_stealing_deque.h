@@ -0,0 +1,159 @@
+/*
+ *work_stealing_deque实现，Chase-Lev 无锁工作窃取双端队列
+ *
+ *队列属于一个线程（owner）：只有 owner 可以在底端 push、pop（后进先出，局部性好）；
+ *其他线程（thief）可以同时从顶端 steal（先进先出，偷走的是最早放入、通常也是最大的任务）。
+ *owner 的 push/pop 在没有竞争时不需要 CAS，只有队列只剩一个元素时才与 thief 以 CAS 争夺顶端
+ *
+ *底层是容量为 2 的幂的环形数组，满了由 owner 扩充为两倍。旧数组可能仍被正在 steal 的线程读取，
+ *因此不立即释放，而是挂在 retired 链上，待队列析构时统一释放
+ *
+ *元素以 std::atomic<T> 存放，T 必须可以平凡复制（通常是指向任务的指针）
+ *内存序采用 Lê、Pop、Cohen、Zappa Nardelli 给出的 C11 版本，其中的 seq_cst 栅栏以 seq_cst 的原子操作代替
+ *
+ *缺省使用第一级空间配置器：扩充数组的是各个 owner 线程，而第二级空间配置器的内存池不是线程安全的
+ */
+
+#ifndef _STL_WORK_STEALING_DEQUE_H_
+#define _STL_WORK_STEALING_DEQUE_H_
+
+#include "1stl_alloctor.h"		//空间配置器
+#include "28stl_mpmc_queue.h"	//for __cache_line_size __mpmc_round_up
+#include <atomic>
+#include <cstddef>				//for ptrdiff_t size_t
+#include <new>					//for placement new
+
+namespace lfp {
+namespace detail {
+
+	//环形数组，下标为不取模的逻辑位置
+	template<class T, class Alloc>
+	struct __ws_array {
+		typedef simple_alloc<std::atomic<T>, Alloc> slot_allocator;
+		typedef simple_alloc<__ws_array, Alloc> array_allocator;
+
+		size_t mask;
+		std::atomic<T>* slots;
+		__ws_array* retired;		//被本数组取代的旧数组
+
+		static __ws_array* create(size_t capacity) {
+			__ws_array* a = array_allocator::allocate();
+			a->mask = capacity - 1;
+			a->slots = slot_allocator::allocate(capacity);
+			for (size_t i = 0; i < capacity; ++i)
+				new (a->slots + i) std::atomic<T>();
+			a->retired = 0;
+			return a;
+		}
+		static void release(__ws_array* a) {
+			slot_allocator::deallocate(a->slots, a->mask + 1);
+			array_allocator::deallocate(a);
+		}
+
+		size_t capacity() const { return mask + 1; }
+		T get(ptrdiff_t i) const { return slots[size_t(i) & mask].load(std::memory_order_relaxed); }
+		void put(ptrdiff_t i, T x) { slots[size_t(i) & mask].store(x, std::memory_order_relaxed); }
+
+		//配置两倍大小的新数组，复制 [top, bottom) 内的元素
+		__ws_array* grow(ptrdiff_t bottom, ptrdiff_t top) const {
+			__ws_array* a = create(capacity() * 2);
+			for (ptrdiff_t i = top; i != bottom; ++i)
+				a->put(i, get(i));
+			return a;
+		}
+	};
+
+}// end of namespace detail
+
+
+
+	template<class T, class Alloc = detail::malloc_alloc>
+	class work_stealing_deque {
+	public:
+		typedef T			value_type;
+		typedef size_t		size_type;
+
+	private:
+		typedef detail::__ws_array<T, Alloc> array_type;
+
+		char pad0[detail::__cache_line_size];
+		std::atomic<ptrdiff_t> top;			//thief 从这里 steal
+		char pad1[detail::__cache_line_size - sizeof(std::atomic<ptrdiff_t>)];
+		std::atomic<ptrdiff_t> bottom;		//owner 在这里 push、pop
+		std::atomic<array_type*> array;
+		char pad2[detail::__cache_line_size - sizeof(std::atomic<ptrdiff_t>) - sizeof(std::atomic<array_type*>)];
+
+		work_stealing_deque(const work_stealing_deque&);
+		work_stealing_deque& operator=(const work_stealing_deque&);
+
+	public:
+		//初始容量为不小于 n 的 2 的幂
+		explicit work_stealing_deque(size_type n = 64) : top(0), bottom(0), array(array_type::create(detail::__mpmc_round_up(n))) { }
+		//析构时不得再有线程访问队列
+		~work_stealing_deque() {
+			array_type* a = array.load(std::memory_order_relaxed);
+			while (a) {
+				array_type* next = a->retired;
+				array_type::release(a);
+				a = next;
+			}
+		}
+
+		//元素个数的近似值，其他线程同时操作时仅供参考
+		size_type size_approx() const {
+			ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+			ptrdiff_t t = top.load(std::memory_order_relaxed);
+			return b > t ? size_type(b - t) : 0;
+		}
+		bool empty_approx() const { return size_approx() == 0; }
+
+		/* 以下由 owner 调用 */
+		//在底端加入 x，数组已满时扩充
+		void push(T x) {
+			ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+			ptrdiff_t t = top.load(std::memory_order_acquire);
+			array_type* a = array.load(std::memory_order_relaxed);
+			if (b - t > ptrdiff_t(a->capacity()) - 1) {
+				array_type* bigger = a->grow(b, t);
+				bigger->retired = a;
+				array.store(bigger, std::memory_order_release);
+				a = bigger;
+			}
+			a->put(b, x);
+			bottom.store(b + 1, std::memory_order_release);
+		}
+		//从底端取出一个元素存入 x，队列空（或最后一个元素被 thief 抢走）时返回 false
+		bool pop(T& x) {
+			ptrdiff_t b = bottom.load(std::memory_order_relaxed) - 1;
+			array_type* a = array.load(std::memory_order_relaxed);
+			bottom.store(b, std::memory_order_seq_cst);
+			ptrdiff_t t = top.load(std::memory_order_seq_cst);
+			if (t > b) {		//队列原本就是空的
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return false;
+			}
+			x = a->get(b);
+			if (t == b) {		//只剩最后一个元素，与 thief 争夺
+				bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return won;
+			}
+			return true;
+		}
+
+		/* 以下可由任意线程调用 */
+		//从顶端偷取一个元素存入 x。队列空或与其他线程竞争失败时返回 false
+		bool steal(T& x) {
+			ptrdiff_t t = top.load(std::memory_order_seq_cst);
+			ptrdiff_t b = bottom.load(std::memory_order_seq_cst);
+			if (t >= b)
+				return false;
+			array_type* a = array.load(std::memory_order_acquire);
+			x = a->get(t);
+			return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+	};
+
+}// end of namespace lfp
+
+#endif // !_STL_WORK_STEALING_DEQUE_H_
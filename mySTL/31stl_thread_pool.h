@@ -0,0 +1,344 @@
+/*
+ *thread_pool、task_group实现，基于工作窃取的任务调度器
+ *
+ *每个工作线程拥有一个 work_stealing_deque：
+ *	工作线程内产生的任务放入自己队列的底端，也从底端取任务执行（后进先出，刚产生的任务数据还在 cache 中）；
+ *	自己的队列空了，先看外部线程提交的任务，再随机选一个其他工作线程，从其队列顶端偷取任务
+ *这样负载由空闲线程主动去平衡，不必事先静态划分
+ *
+ *外部线程提交的任务放入一个受互斥量保护的公共队列。所有线程都找不到任务时在条件变量上休眠，
+ *提交任务时只有确实有线程在休眠才会去唤醒
+ *
+ *task_group 用于等待一组任务完成：wait() 在等待期间也会执行池中的任务，因此任务内部可以再建立
+ *task_group、递归地分解工作而不会死锁。任务抛出的第一个异常由 wait() 重新抛出。
+ *直接以 thread_pool::submit 提交的任务不得抛出异常，否则调用 std::terminate
+ *
+ *parallel_for(pool, first, last, grain, f) 将 [first, last) 递归对半分解，直到长度不超过 grain，
+ *对每一段调用 f(段首, 段尾)。first、last 可以是整数下标，也可以是随机访问迭代器
+ */
+
+#ifndef _STL_THREAD_POOL_H_
+#define _STL_THREAD_POOL_H_
+
+#include "1stl_alloctor.h"					//for malloc_alloc
+#include "4stl_vector.h"
+#include "6stl_deque.h"
+#include "30stl_work_stealing_deque.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>						//for exception_ptr
+#include <functional>						//for function
+#include <mutex>
+#include <thread>
+
+namespace lfp {
+
+	class thread_pool;
+	class task_group;
+
+namespace detail {
+
+	struct __pool_task {
+		std::function<void()> fn;
+		task_group* group;		//所属的 task_group，可以为空
+
+		__pool_task(const std::function<void()>& f, task_group* g) : fn(f), group(g) { }
+	};
+
+	struct __pool_worker {
+		thread_pool* pool;
+		work_stealing_deque<__pool_task*> tasks;
+		std::thread thread;
+		unsigned int seed;		//选择偷取对象的随机数种子
+
+		__pool_worker(thread_pool* p, unsigned int s) : pool(p), seed(s) { }
+	};
+
+	//当前线程所属的工作线程，非工作线程为空
+	inline __pool_worker*& __current_worker() {
+		static thread_local __pool_worker* worker = 0;
+		return worker;
+	}
+
+}// end of namespace detail
+
+
+
+	class thread_pool {
+		friend class task_group;
+
+	public:
+		typedef size_t size_type;
+
+	private:
+		vector<detail::__pool_worker*> workers;
+		std::mutex inject_mutex;
+		deque<detail::__pool_task*, detail::malloc_alloc> injected;		//外部线程提交的任务
+		std::atomic<size_type> pending;		//已提交、尚未被取走的任务个数
+		std::atomic<size_type> sleepers;	//正在休眠的工作线程个数
+		std::atomic<bool> stopping;
+		std::mutex sleep_mutex;
+		std::condition_variable wake;
+
+		thread_pool(const thread_pool&);
+		thread_pool& operator=(const thread_pool&);
+
+		//w 为当前工作线程（不属于本线程池时为空），依次查找自己的队列、公共队列、其他工作线程的队列
+		detail::__pool_task* find_task(detail::__pool_worker* w);
+		//放入任务失败（配置空间时抛出异常）时撤销计数、释放 task，再重新抛出
+		void enqueue(detail::__pool_task* task);
+		static void execute(detail::__pool_task* task);
+		//不属于任何 task_group 的任务无处传播异常，抛出时直接 std::terminate
+		static void run_detached(std::function<void()>& fn) noexcept { fn(); }
+		void worker_loop(detail::__pool_worker* w);
+
+		//当前线程若是本线程池的工作线程则传回它，否则传回空
+		detail::__pool_worker* local_worker() const {
+			detail::__pool_worker* w = detail::__current_worker();
+			return (w && w->pool == this) ? w : 0;
+		}
+		//找到一个任务就在当前线程中执行，供 task_group::wait 使用
+		bool help_one() {
+			detail::__pool_task* task = find_task(local_worker());
+			if (task == 0)
+				return false;
+			execute(task);
+			return true;
+		}
+
+	public:
+		//启动 n 个工作线程，n 为0时使用硬件支持的并发线程数
+		explicit thread_pool(size_type n = 0);
+		//执行完所有已提交的任务后结束工作线程
+		~thread_pool();
+
+		size_type size() const { return workers.size(); }
+
+		//提交一个不属于任何 task_group 的任务
+		template<class Function>
+		void submit(Function f) { enqueue(new detail::__pool_task(f, 0)); }
+	};
+
+
+
+	class task_group {
+		friend class thread_pool;
+
+	private:
+		thread_pool& pool;
+		std::atomic<size_t> outstanding;		//尚未完成的任务个数
+		std::atomic<bool> failed;
+		std::exception_ptr error;				//第一个失败任务抛出的异常
+
+		task_group(const task_group&);
+		task_group& operator=(const task_group&);
+
+		void finish_task() { outstanding.fetch_sub(1, std::memory_order_release); }
+		void set_error(std::exception_ptr e) {
+			if (!failed.exchange(true))
+				error = e;
+		}
+
+	public:
+		explicit task_group(thread_pool& p) : pool(p), outstanding(0), failed(false) { }
+		//析构前必须等待所有任务完成，此时不再传播异常
+		~task_group() {
+			try {
+				wait();
+			}
+			catch (...) { }
+		}
+
+		//先生成任务再计数：生成任务时抛出异常不影响 outstanding；放入失败时撤销计数
+		template<class Function>
+		void run(Function f) {
+			detail::__pool_task* task = new detail::__pool_task(f, this);
+			outstanding.fetch_add(1, std::memory_order_relaxed);
+			try {
+				pool.enqueue(task);
+			}
+			catch (...) {
+				finish_task();
+				throw;
+			}
+		}
+
+		//等待本组所有任务完成，等待期间帮助执行池中的任务。若有任务抛出异常，重新抛出第一个
+		void wait() {
+			while (outstanding.load(std::memory_order_acquire) != 0) {
+				if (!pool.help_one())
+					std::this_thread::yield();
+			}
+			if (failed.load(std::memory_order_acquire)) {
+				std::exception_ptr e = error;
+				error = std::exception_ptr();
+				failed.store(false, std::memory_order_relaxed);
+				std::rethrow_exception(e);
+			}
+		}
+	};
+
+
+
+	inline thread_pool::thread_pool(size_type n) : pending(0), sleepers(0), stopping(false) {
+		if (n == 0)
+			n = std::thread::hardware_concurrency();
+		if (n == 0)
+			n = 1;
+		workers.reserve(n);
+		for (size_type i = 0; i < n; ++i)
+			workers.push_back(new detail::__pool_worker(this, (unsigned int)(i * 2654435761u + 1)));
+		for (size_type i = 0; i < n; ++i)
+			workers[i]->thread = std::thread(&thread_pool::worker_loop, this, workers[i]);
+	}
+
+	inline thread_pool::~thread_pool() {
+		stopping.store(true);
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			wake.notify_all();
+		}
+		//其他线程可能仍在偷取某个队列，全部结束后才能释放
+		for (size_type i = 0; i < workers.size(); ++i)
+			workers[i]->thread.join();
+		for (size_type i = 0; i < workers.size(); ++i)
+			delete workers[i];
+	}
+
+	inline detail::__pool_task* thread_pool::find_task(detail::__pool_worker* w) {
+		detail::__pool_task* task = 0;
+		if (w && w->tasks.pop(task)) {
+			pending.fetch_sub(1);
+			return task;
+		}
+		{
+			std::lock_guard<std::mutex> lock(inject_mutex);
+			if (!injected.empty()) {
+				task = injected.front();
+				injected.pop_front();
+				pending.fetch_sub(1);
+				return task;
+			}
+		}
+		//从一个随机的工作线程开始，依次尝试偷取
+		size_type n = workers.size();
+		size_type start;
+		if (w) {
+			w->seed = w->seed * 1103515245u + 12345u;
+			start = (w->seed >> 16) % n;
+		}
+		else {
+			start = 0;
+		}
+		for (size_type i = 0; i < n; ++i) {
+			detail::__pool_worker* victim = workers[(start + i) % n];
+			if (victim != w && victim->tasks.steal(task)) {
+				pending.fetch_sub(1);
+				return task;
+			}
+		}
+		return 0;
+	}
+
+	inline void thread_pool::enqueue(detail::__pool_task* task) {
+		pending.fetch_add(1);		//先计数再放入，保证取走任务时计数不会小于0
+		detail::__pool_worker* w = local_worker();
+		try {
+			if (w) {
+				w->tasks.push(task);
+			}
+			else {
+				std::lock_guard<std::mutex> lock(inject_mutex);
+				injected.push_back(task);
+			}
+		}
+		catch (...) {		//任务没有放入，撤销计数，否则工作线程永远等不到 pending 归0
+			pending.fetch_sub(1);
+			delete task;
+			throw;
+		}
+		//休眠的线程先增加 sleepers 再检查 pending，这里先增加 pending 再检查 sleepers，二者至少有一方能看到对方
+		if (sleepers.load() != 0) {
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			wake.notify_one();
+		}
+	}
+
+	inline void thread_pool::execute(detail::__pool_task* task) {
+		task_group* group = task->group;
+		if (group) {
+			try {
+				task->fn();
+			}
+			catch (...) {
+				group->set_error(std::current_exception());
+			}
+		}
+		else {
+			run_detached(task->fn);
+		}
+		delete task;
+		if (group)
+			group->finish_task();
+	}
+
+	inline void thread_pool::worker_loop(detail::__pool_worker* w) {
+		detail::__current_worker() = w;
+		for (;;) {
+			detail::__pool_task* task = find_task(w);
+			if (task) {
+				execute(task);
+				continue;
+			}
+			if (stopping.load() && pending.load() == 0)
+				return;
+			//先让出几次时间片，仍然没有任务再休眠
+			for (int i = 0; i < 16 && task == 0; ++i) {
+				std::this_thread::yield();
+				task = find_task(w);
+			}
+			if (task) {
+				execute(task);
+				continue;
+			}
+			sleepers.fetch_add(1);
+			{
+				std::unique_lock<std::mutex> lock(sleep_mutex);
+				while (!stopping.load() && pending.load() == 0)
+					wake.wait(lock);
+			}
+			sleepers.fetch_sub(1);
+		}
+	}
+
+
+
+namespace detail {
+
+	template<class Index, class Function>
+	void __parallel_for(task_group& group, Index first, Index last, size_t grain, const Function& f) {
+		//把后一半交给其他线程（可能被偷走），自己继续分解前一半
+		while (size_t(last - first) > grain) {
+			Index mid = first + (last - first) / 2;
+			group.run([&group, mid, last, grain, &f]() { __parallel_for(group, mid, last, grain, f); });
+			last = mid;
+		}
+		f(first, last);
+	}
+
+}// end of namespace detail
+
+	template<class Index, class Function>
+	void parallel_for(thread_pool& pool, Index first, Index last, size_t grain, Function f) {
+		if (grain == 0)
+			grain = 1;
+		if (!(first < last))
+			return;
+		task_group group(pool);
+		detail::__parallel_for(group, first, last, grain, f);
+		group.wait();
+	}
+
+}// end of namespace lfp
+
+#endif // !_STL_THREAD_POOL_H_
@@ -0,0 +1,796 @@
+/*
+ *B树实现，btree_set、btree_multiset、btree_map、btree_multimap 的底层容器
+ *
+ *红黑树每个节点只存放一个元素，另带三个指针和颜色，查找时每下降一层就是一次 cache miss。
+ *B树的一个节点约 256 字节（4 条 cache line），有序地存放多个元素，节点内以二分查找定位：
+ *	·叶节点最多存放 max_count 个元素，对 int 而言一个节点可以放 61 个；内部节点另有 max_count + 1 个子节点指针
+ *	·所有叶节点的深度相同
+ *因此树高只有红黑树的几分之一，每个元素分摊的指针开销也很小
+ *
+ *插入总是发生在叶节点。节点满了就分裂为两个，中间的元素移入父节点（父节点满了先分裂父节点）。
+ *在节点最右端插入时，分裂让原节点保持满载、新节点只放新元素，按序插入建立的树节点几乎都是满的（最左端同理）。
+ *删除内部节点的元素时以其前驱（必在叶节点）取代之，再从叶节点删除；节点的元素少于 max_count / 2 时与相邻的
+ *兄弟节点合并，合并不下则从兄弟节点匀过来一部分，必要时逐层向上调整
+ *
+ *注意：与红黑树不同，插入、删除都会在节点之间搬移元素，因此任何插入、删除都使所有的迭代器失效。
+ *搬移元素时假定其移动构造不会抛出异常
+ */
+
+#ifndef _STL_BTREE_H_
+#define _STL_BTREE_H_
+
+#include "1stl_alloctor.h"			//空间配置器
+#include "1stl_construct.h"			//for destroy
+#include "1stl_iterator.h"
+#include "1stl_type_traits.h"
+#include "2stl_algobase.h"			//for sorted_unique_t
+#include <new>						//for placement new
+#include <string.h>					//for memmove
+#include <type_traits>				//for aligned_storage
+#include <utility>					//for pair move forward
+
+namespace lfp {
+namespace detail {
+
+	enum { __btree_node_size = 256 };		//节点的目标大小
+
+	template<class Value> struct __btree_internal_node;
+
+	//叶节点。内部节点由叶节点派生，多出子节点指针
+	template<class Value>
+	struct __btree_node {
+		typedef __btree_node<Value>* node_pointer;
+		typedef typename std::aligned_storage<sizeof(Value), alignof(Value)>::type slot_type;
+
+		enum {
+			__fit = (__btree_node_size - sizeof(void*) - 4) / sizeof(Value),
+			max_count = __fit < 3 ? 3 : (__fit > 255 ? 255 : __fit),		//节点最多存放的元素个数
+			min_count = max_count / 2										//非根节点最少存放的元素个数
+		};
+
+		node_pointer parent;			//根节点的 parent 为空
+		unsigned char position;			//本节点在父节点 children 中的下标
+		unsigned char count;			//元素个数
+		bool leaf;
+		slot_type slots[max_count];		//前 count 个存放元素
+
+		Value* value(int i) { return reinterpret_cast<Value*>(&slots[i]); }
+		node_pointer& child(int i) { return static_cast<__btree_internal_node<Value>*>(this)->children[i]; }
+		void set_child(int i, node_pointer x) {
+			child(i) = x;
+			x->parent = this;
+			x->position = (unsigned char)i;
+		}
+	};
+
+	template<class Value>
+	struct __btree_internal_node : public __btree_node<Value> {
+		__btree_node<Value>* children[__btree_node<Value>::max_count + 1];
+	};
+
+
+
+	//B树的迭代器由节点和节点内的下标组成，end() 为最右叶节点的最后一个元素之后
+	template<class Value, class Ref, class Ptr>
+	struct __btree_iterator {
+		typedef bidirectional_iterator_tag		iterator_category;
+		typedef Value							value_type;
+		typedef Ref								reference;
+		typedef Ptr								pointer;
+		typedef ptrdiff_t						difference_type;
+
+		typedef __btree_iterator<Value, Value&, Value*>					iterator;
+		typedef __btree_iterator<Value, const Value&, const Value*>		const_iterator;
+		typedef __btree_iterator<Value, Ref, Ptr>						self;
+		typedef __btree_node<Value>*									node_pointer;
+
+		node_pointer node;
+		int position;
+
+		__btree_iterator() : node(0), position(0) { }
+		__btree_iterator(node_pointer x, int i) : node(x), position(i) { }
+		__btree_iterator(const iterator& it) : node(it.node), position(it.position) { }
+
+		reference operator*() const { return *node->value(position); }
+		pointer operator->() const { return &(operator*()); }
+
+		self& operator++() {
+			if (node->leaf && ++position < node->count)
+				return *this;
+			increment_slow();
+			return *this;
+		}
+		self operator++(int) {
+			self tmp = *this;
+			++*this;
+			return tmp;
+		}
+		self& operator--() {
+			if (node->leaf && --position >= 0)
+				return *this;
+			decrement_slow();
+			return *this;
+		}
+		self operator--(int) {
+			self tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		bool operator==(const iterator& x) const { return node == x.node && position == x.position; }
+		bool operator!=(const iterator& x) const { return node != x.node || position != x.position; }
+		bool operator==(const const_iterator& x) const { return node == x.node && position == x.position; }
+		bool operator!=(const const_iterator& x) const { return node != x.node || position != x.position; }
+
+	private:
+		void increment_slow() {
+			if (node->leaf) {
+				//已越过叶节点的最后一个元素，向上找到第一个从左子树上来的祖先
+				node_pointer save_node = node;
+				int save_position = position;
+				while (position == node->count && node->parent) {
+					position = node->position;
+					node = node->parent;
+				}
+				if (position == node->count) {	//原本是最后一个元素，停在 end()
+					node = save_node;
+					position = save_position;
+				}
+			}
+			else {
+				//内部节点的后继是右子树的最左元素
+				node = node->child(position + 1);
+				while (!node->leaf)
+					node = node->child(0);
+				position = 0;
+			}
+		}
+		void decrement_slow() {
+			if (node->leaf) {
+				node_pointer save_node = node;
+				int save_position = position;
+				while (position < 0 && node->parent) {
+					position = node->position - 1;
+					node = node->parent;
+				}
+				if (position < 0) {				//begin() 没有前驱
+					node = save_node;
+					position = save_position;
+				}
+			}
+			else {
+				node = node->child(position);
+				while (!node->leaf)
+					node = node->child(node->count);
+				position = node->count - 1;
+			}
+		}
+	};
+
+
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc = alloc>
+	class btree {
+	protected:
+		typedef __btree_node<Value>								leaf_node;
+		typedef __btree_internal_node<Value>					internal_node;
+		typedef leaf_node*										node_pointer;
+		typedef simple_alloc<leaf_node, Alloc>					leaf_allocator;
+		typedef simple_alloc<internal_node, Alloc>				internal_allocator;
+		typedef typename __type_traits<Value>::is_POD_type		trivial_value;
+		typedef btree<Key, Value, KeyOfValue, Compare, Alloc>	self;
+
+		enum { max_count = leaf_node::max_count, min_count = leaf_node::min_count };
+
+	public:
+		typedef Key					key_type;
+		typedef Value				value_type;
+		typedef value_type*			pointer;
+		typedef const value_type*	const_pointer;
+		typedef value_type&			reference;
+		typedef const value_type&	const_reference;
+		typedef size_t				size_type;
+		typedef ptrdiff_t			difference_type;
+
+		typedef __btree_iterator<value_type, reference, pointer>				iterator;
+		typedef __btree_iterator<value_type, const_reference, const_pointer>	const_iterator;
+
+	protected:
+		node_pointer root;			//空树时 root、leftmost、rightmost 均为空
+		node_pointer leftmost;		//最左叶节点
+		node_pointer rightmost;		//最右叶节点
+		size_type value_count;		//元素个数
+		Compare key_compare;
+
+		node_pointer create_leaf() {
+			node_pointer x = leaf_allocator::allocate();
+			x->parent = 0;
+			x->position = 0;
+			x->count = 0;
+			x->leaf = true;
+			return x;
+		}
+		node_pointer create_internal() {
+			node_pointer x = internal_allocator::allocate();
+			x->parent = 0;
+			x->position = 0;
+			x->count = 0;
+			x->leaf = false;
+			return x;
+		}
+		void free_node(node_pointer x) {
+			if (x->leaf)
+				leaf_allocator::deallocate(x);
+			else
+				internal_allocator::deallocate(static_cast<internal_node*>(x));
+		}
+
+		static const Key& key(node_pointer x, int i) { return KeyOfValue()(*x->value(i)); }
+		static const Key& key(const_iterator it) { return KeyOfValue()(*it); }
+
+		//把 src 开始的 n 个元素搬到 dst（src 处的元素随之失效），两段可以重叠
+		static void relocate(Value* dst, Value* src, int n) {
+			if (n > 0 && dst != src)
+				__relocate(dst, src, n, trivial_value());
+		}
+		static void __relocate(Value* dst, Value* src, int n, __true_type) {
+			memmove(dst, src, n * sizeof(Value));
+		}
+		static void __relocate(Value* dst, Value* src, int n, __false_type) {
+			if (dst < src) {
+				for (int i = 0; i < n; ++i) {
+					new (dst + i) Value(std::move(src[i]));
+					destroy(src + i);
+				}
+			}
+			else {
+				for (int i = n - 1; i >= 0; --i) {
+					new (dst + i) Value(std::move(src[i]));
+					destroy(src + i);
+				}
+			}
+		}
+
+		static void destroy_values(node_pointer x) { __destroy_values(x, trivial_value()); }
+		static void __destroy_values(node_pointer, __true_type) { }
+		static void __destroy_values(node_pointer x, __false_type) {
+			for (int i = 0; i < x->count; ++i)
+				destroy(x->value(i));
+		}
+
+	public:
+		btree(const Compare& comp = Compare())
+			: root(0), leftmost(0), rightmost(0), value_count(0), key_compare(comp) { }
+		btree(const self& x)
+			: root(0), leftmost(0), rightmost(0), value_count(0), key_compare(x.key_compare) {
+			__copy_from(x);
+		}
+		~btree() { clear(); }
+
+		self& operator=(const self& x) {
+			if (this != &x) {
+				clear();
+				key_compare = x.key_compare;
+				__copy_from(x);
+			}
+			return *this;
+		}
+
+	public:
+		Compare key_comp() const { return key_compare; }
+		iterator begin() { return iterator(leftmost, 0); }
+		const_iterator begin() const { return const_iterator(leftmost, 0); }
+		iterator end() { return iterator(rightmost, rightmost ? rightmost->count : 0); }
+		const_iterator end() const { return const_iterator(rightmost, rightmost ? rightmost->count : 0); }
+		bool empty() const { return value_count == 0; }
+		size_type size() const { return value_count; }
+		size_type max_size() const { return size_type(-1); }
+
+		void swap(self& x) {
+			lfp::swap(root, x.root);
+			lfp::swap(leftmost, x.leftmost);
+			lfp::swap(rightmost, x.rightmost);
+			lfp::swap(value_count, x.value_count);
+			lfp::swap(key_compare, x.key_compare);
+		}
+
+		void clear() {
+			if (root) {
+				__erase_subtree(root);
+				root = leftmost = rightmost = 0;
+				value_count = 0;
+			}
+		}
+
+	public:
+		//insert/erase
+		std::pair<iterator, bool> insert_unique(const value_type& v) { return __insert_unique(v); }
+		iterator insert_equal(const value_type& v) { return __insert_equal(v); }
+		//pos 为提示：新元素应紧邻 pos 之前。提示正确时只需一两次比较，否则退化为一般的插入
+		iterator insert_unique(const_iterator pos, const value_type& v) {
+			return __insert_hint_unique(__mutable(pos), v);
+		}
+		iterator insert_equal(const_iterator pos, const value_type& v) {
+			return __insert_hint_equal(__mutable(pos), v);
+		}
+		//先构造出元素才能取得键值，找到位置后再移入树中
+		template<class... Args>
+		std::pair<iterator, bool> emplace_unique(Args&&... args) {
+			value_type tmp(std::forward<Args>(args)...);
+			return __insert_unique(std::move(tmp));
+		}
+		template<class... Args>
+		iterator emplace_equal(Args&&... args) {
+			value_type tmp(std::forward<Args>(args)...);
+			return __insert_equal(std::move(tmp));
+		}
+		template<class... Args>
+		iterator emplace_hint_unique(const_iterator pos, Args&&... args) {
+			value_type tmp(std::forward<Args>(args)...);
+			return __insert_hint_unique(__mutable(pos), std::move(tmp));
+		}
+		template<class... Args>
+		iterator emplace_hint_equal(const_iterator pos, Args&&... args) {
+			value_type tmp(std::forward<Args>(args)...);
+			return __insert_hint_equal(__mutable(pos), std::move(tmp));
+		}
+		//以 end() 为提示逐个插入，已排序的输入每个元素均摊常数时间
+		template<class InputIterator>
+		void insert_unique(InputIterator first, InputIterator last) {
+			for (; first != last; ++first)
+				insert_unique(end(), *first);
+		}
+		template<class InputIterator>
+		void insert_equal(InputIterator first, InputIterator last) {
+			for (; first != last; ++first)
+				insert_equal(end(), *first);
+		}
+		//清空后以 [first, last) 建树，调用者保证其已排序，不做任何比较
+		template<class InputIterator>
+		void assign_sorted(InputIterator first, InputIterator last) {
+			clear();
+			for (; first != last; ++first)
+				__append(*first);
+		}
+
+		void erase(const_iterator pos) { __erase(__mutable(pos)); }
+		size_type erase(const key_type& k) {
+			size_type n = 0;
+			iterator it = lower_bound(k);
+			while (it != end() && !key_compare(k, key(it))) {
+				it = __erase(it);
+				++n;
+			}
+			return n;
+		}
+		void erase(const_iterator first, const_iterator last) {
+			if (first == begin() && last == end()) {
+				clear();
+				return;
+			}
+			//每次删除都可能搬移元素，先数出个数，再从 first 开始逐个删除
+			size_type n = 0;
+			for (const_iterator it = first; it != last; ++it)
+				++n;
+			iterator it = __mutable(first);
+			while (n--)
+				it = __erase(it);
+		}
+
+	public:
+		//set/map operations
+		iterator find(const key_type& k) {
+			iterator it = lower_bound(k);
+			return (it == end() || key_compare(k, key(it))) ? end() : it;
+		}
+		const_iterator find(const key_type& k) const {
+			const_iterator it = lower_bound(k);
+			return (it == end() || key_compare(k, key(it))) ? end() : it;
+		}
+		size_type count(const key_type& k) const {
+			size_type n = 0;
+			for (const_iterator it = lower_bound(k); it != end() && !key_compare(k, key(it)); ++it)
+				++n;
+			return n;
+		}
+		iterator lower_bound(const key_type& k) { return __lower_bound(k); }
+		const_iterator lower_bound(const key_type& k) const { return __lower_bound(k); }
+		iterator upper_bound(const key_type& k) { return __upper_bound(k); }
+		const_iterator upper_bound(const key_type& k) const { return __upper_bound(k); }
+		std::pair<iterator, iterator> equal_range(const key_type& k) {
+			return std::pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+		}
+		std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			return std::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+		}
+
+	protected:
+		iterator __mutable(const_iterator it) const { return iterator(it.node, it.position); }
+
+		//节点内第一个不小于 k 的元素的下标。每轮只根据比较结果决定是否移动起点，
+		//编译器可以生成条件传送而非分支，随机查找时不会因分支预测失败而停顿
+		int __lower_in_node(node_pointer x, const Key& k) const {
+			int first = 0, len = x->count;
+			if (len == 0)
+				return 0;
+			while (len > 1) {
+				int half = len >> 1;
+				first = key_compare(key(x, first + half), k) ? first + half : first;
+				len -= half;
+			}
+			return first + (key_compare(key(x, first), k) ? 1 : 0);
+		}
+		//节点内第一个大于 k 的元素的下标
+		int __upper_in_node(node_pointer x, const Key& k) const {
+			int first = 0, len = x->count;
+			if (len == 0)
+				return 0;
+			while (len > 1) {
+				int half = len >> 1;
+				first = key_compare(k, key(x, first + half)) ? first : first + half;
+				len -= half;
+			}
+			return first + (key_compare(k, key(x, first)) ? 0 : 1);
+		}
+
+		//沿途记录最深的候选位置：叶节点内找不到时，答案是最近一个在节点内找到位置的祖先
+		iterator __lower_bound(const Key& k) const {
+			iterator res(rightmost, rightmost ? rightmost->count : 0);
+			for (node_pointer x = root; x; ) {
+				int i = __lower_in_node(x, k);
+				if (i < x->count)
+					res = iterator(x, i);
+				if (x->leaf)
+					break;
+				x = x->child(i);
+			}
+			return res;
+		}
+		iterator __upper_bound(const Key& k) const {
+			iterator res(rightmost, rightmost ? rightmost->count : 0);
+			for (node_pointer x = root; x; ) {
+				int i = __upper_in_node(x, k);
+				if (i < x->count)
+					res = iterator(x, i);
+				if (x->leaf)
+					break;
+				x = x->child(i);
+			}
+			return res;
+		}
+
+		//在叶节点 x 的下标 i 处插入以 v 构造的元素，节点已满时先分裂。
+		//先构造出新元素再搬移其他元素，即使 v 引用的是树中的元素也不受影响
+		template<class Arg>
+		iterator __insert_at(node_pointer x, int i, Arg&& v) {
+			value_type tmp(std::forward<Arg>(v));
+			if (x->count == max_count)
+				__split(x, i);
+			relocate(x->value(i + 1), x->value(i), x->count - i);
+			new (x->value(i)) value_type(std::move(tmp));
+			++x->count;
+			++value_count;
+			return iterator(x, i);
+		}
+
+		//分裂已满的节点 x，i 为将要插入的位置，分裂后 x、i 指向新元素所在的节点和下标
+		void __split(node_pointer& x, int& i) {
+			node_pointer parent = x->parent;
+			if (parent == 0) {
+				parent = create_internal();
+				parent->set_child(0, x);
+				root = parent;
+			}
+			else if (parent->count == max_count) {
+				int p = x->position;
+				__split(parent, p);
+				parent = x->parent;
+			}
+			//在最右端插入时原节点保持满载，最左端插入时原节点只留新元素，其余情况对半分
+			int left_count;
+			if (i == max_count)
+				left_count = max_count - 1;
+			else if (i == 0)
+				left_count = 0;
+			else
+				left_count = max_count / 2;
+
+			node_pointer y = x->leaf ? create_leaf() : create_internal();
+			int moved = x->count - left_count - 1;
+			relocate(y->value(0), x->value(left_count + 1), moved);
+			if (!x->leaf) {
+				for (int j = 0; j <= moved; ++j)
+					y->set_child(j, x->child(left_count + 1 + j));
+			}
+			y->count = (unsigned char)moved;
+
+			//中间的元素移入父节点，y 成为 x 右边的兄弟
+			int p = x->position;
+			relocate(parent->value(p + 1), parent->value(p), parent->count - p);
+			relocate(parent->value(p), x->value(left_count), 1);
+			for (int j = parent->count; j > p; --j)
+				parent->set_child(j + 1, parent->child(j));
+			parent->set_child(p + 1, y);
+			++parent->count;
+			x->count = (unsigned char)left_count;
+
+			if (x == rightmost)
+				rightmost = y;
+			if (i > left_count) {
+				x = y;
+				i -= left_count + 1;
+			}
+		}
+
+		template<class Arg>
+		std::pair<iterator, bool> __insert_unique(Arg&& v) {
+			if (root == 0)
+				return std::pair<iterator, bool>(__append(std::forward<Arg>(v)), true);
+			const Key& k = KeyOfValue()(v);
+			node_pointer x = root;
+			for (;;) {
+				int i = __lower_in_node(x, k);
+				if (i < x->count && !key_compare(k, key(x, i)))
+					return std::pair<iterator, bool>(iterator(x, i), false);
+				if (x->leaf)
+					return std::pair<iterator, bool>(__insert_at(x, i, std::forward<Arg>(v)), true);
+				x = x->child(i);
+			}
+		}
+		//键值相同的元素，新元素放在最后
+		template<class Arg>
+		iterator __insert_equal(Arg&& v) {
+			if (root == 0)
+				return __append(std::forward<Arg>(v));
+			const Key& k = KeyOfValue()(v);
+			node_pointer x = root;
+			for (;;) {
+				int i = __upper_in_node(x, k);
+				if (x->leaf)
+					return __insert_at(x, i, std::forward<Arg>(v));
+				x = x->child(i);
+			}
+		}
+
+		//在 pos 之前插入，调用者保证次序正确
+		template<class Arg>
+		iterator __insert_before(iterator pos, Arg&& v) {
+			if (root == 0)
+				return __append(std::forward<Arg>(v));
+			if (pos.node->leaf)
+				return __insert_at(pos.node, pos.position, std::forward<Arg>(v));
+			//内部节点的元素之前是其前驱之后，前驱必在叶节点的末尾
+			--pos;
+			return __insert_at(pos.node, pos.position + 1, std::forward<Arg>(v));
+		}
+		template<class Arg>
+		iterator __append(Arg&& v) {
+			if (root == 0)
+				root = leftmost = rightmost = create_leaf();
+			return __insert_at(rightmost, rightmost->count, std::forward<Arg>(v));
+		}
+
+		template<class Arg>
+		iterator __insert_hint_unique(iterator pos, Arg&& v) {
+			const Key& k = KeyOfValue()(v);
+			if (pos == end() || key_compare(k, key(pos))) {
+				//v 应在 pos 之前，再确认 pos 的前驱小于 v
+				if (pos == begin())
+					return __insert_before(pos, std::forward<Arg>(v));
+				iterator before = pos;
+				--before;
+				if (key_compare(key(before), k))
+					return __insert_before(pos, std::forward<Arg>(v));
+			}
+			else if (key_compare(key(pos), k)) {
+				//v 应在 pos 之后，再确认 pos 的后继大于 v
+				iterator after = pos;
+				++after;
+				if (after == end() || key_compare(k, key(after)))
+					return __insert_before(after, std::forward<Arg>(v));
+			}
+			else {
+				return pos;		//键值重复
+			}
+			return __insert_unique(std::forward<Arg>(v)).first;
+		}
+		template<class Arg>
+		iterator __insert_hint_equal(iterator pos, Arg&& v) {
+			const Key& k = KeyOfValue()(v);
+			if (pos == end() || !key_compare(key(pos), k)) {
+				if (pos == begin())
+					return __insert_before(pos, std::forward<Arg>(v));
+				iterator before = pos;
+				--before;
+				if (!key_compare(k, key(before)))
+					return __insert_before(pos, std::forward<Arg>(v));
+			}
+			else {
+				iterator after = pos;
+				++after;
+				if (after == end() || !key_compare(key(after), k))
+					return __insert_before(after, std::forward<Arg>(v));
+			}
+			return __insert_equal(std::forward<Arg>(v));
+		}
+
+		//删除 pos 所指的元素，传回其后继
+		iterator __erase(iterator pos) {
+			bool internal_delete = !pos.node->leaf;
+			destroy(pos.node->value(pos.position));
+			if (internal_delete) {
+				//以前驱取代之，转为删除叶节点中前驱原来的位置
+				iterator before = pos;
+				--before;
+				relocate(pos.node->value(pos.position), before.node->value(before.position), 1);
+				pos = before;
+			}
+			node_pointer x = pos.node;
+			relocate(x->value(pos.position), x->value(pos.position + 1), x->count - pos.position - 1);
+			--x->count;
+			--value_count;
+
+			pos = __rebalance_after_erase(pos);
+			if (root == 0)
+				return end();
+			//pos 可能在叶节点的最后一个元素之后
+			while (pos.position == pos.node->count && pos.node->parent) {
+				pos.position = pos.node->position;
+				pos.node = pos.node->parent;
+			}
+			if (pos.position == pos.node->count)
+				return end();
+			if (internal_delete)		//此时 pos 指向取代被删元素的前驱
+				++pos;
+			return pos;
+		}
+
+		//叶节点 pos.node 刚删除了一个元素，自下而上合并或匀元素。传回调整后原位置所在的地方
+		iterator __rebalance_after_erase(iterator pos) {
+			iterator res = pos;
+			node_pointer x = pos.node;
+			bool first = true;
+			while (x != root && x->count < min_count) {
+				iterator it(x, first ? res.position : 0);
+				bool merged = __merge_or_rebalance(it);
+				if (first) {
+					res = it;
+					first = false;
+				}
+				if (!merged)
+					break;
+				x = it.node->parent;
+			}
+			if (root->count == 0) {
+				node_pointer old = root;
+				if (root->leaf) {
+					root = leftmost = rightmost = 0;
+				}
+				else {
+					root = root->child(0);
+					root->parent = 0;
+					root->position = 0;
+				}
+				free_node(old);
+			}
+			return res;
+		}
+
+		//it.node 的元素不足。能与兄弟合并则合并（传回 true），否则从兄弟匀过来一部分。it 随元素一起移动
+		bool __merge_or_rebalance(iterator& it) {
+			node_pointer x = it.node;
+			node_pointer parent = x->parent;
+			int p = x->position;
+			if (p > 0) {
+				node_pointer left = parent->child(p - 1);
+				if (left->count + 1 + x->count <= max_count) {
+					it.position += left->count + 1;
+					__merge(left, x);
+					it.node = left;
+					return true;
+				}
+			}
+			if (p < parent->count) {
+				node_pointer right = parent->child(p + 1);
+				if (x->count + 1 + right->count <= max_count) {
+					__merge(x, right);
+					return true;
+				}
+				if (right->count > min_count) {
+					int n = (right->count - x->count) / 2;
+					__move_left(x, right, n);
+					return false;
+				}
+			}
+			if (p > 0) {
+				node_pointer left = parent->child(p - 1);
+				if (left->count > min_count) {
+					int n = (left->count - x->count) / 2;
+					__move_right(left, x, n);
+					it.position += n;
+					return false;
+				}
+			}
+			return false;
+		}
+
+		//把父节点中的分隔元素和 right 的全部内容并入其左兄弟 left，释放 right
+		void __merge(node_pointer left, node_pointer right) {
+			node_pointer parent = left->parent;
+			int p = left->position;
+			int n = left->count;
+			relocate(left->value(n), parent->value(p), 1);
+			relocate(left->value(n + 1), right->value(0), right->count);
+			if (!left->leaf) {
+				for (int j = 0; j <= right->count; ++j)
+					left->set_child(n + 1 + j, right->child(j));
+			}
+			left->count = (unsigned char)(n + 1 + right->count);
+
+			relocate(parent->value(p), parent->value(p + 1), parent->count - p - 1);
+			for (int j = p + 2; j <= parent->count; ++j)
+				parent->set_child(j - 1, parent->child(j));
+			--parent->count;
+
+			if (right == rightmost)
+				rightmost = left;
+			free_node(right);
+		}
+
+		//从右兄弟 right 匀 n 个元素给 left（经由父节点的分隔元素）
+		void __move_left(node_pointer left, node_pointer right, int n) {
+			node_pointer parent = left->parent;
+			int p = left->position;
+			int c = left->count;
+			relocate(left->value(c), parent->value(p), 1);
+			relocate(left->value(c + 1), right->value(0), n - 1);
+			relocate(parent->value(p), right->value(n - 1), 1);
+			relocate(right->value(0), right->value(n), right->count - n);
+			if (!left->leaf) {
+				for (int j = 0; j < n; ++j)
+					left->set_child(c + 1 + j, right->child(j));
+				for (int j = n; j <= right->count; ++j)
+					right->set_child(j - n, right->child(j));
+			}
+			left->count = (unsigned char)(c + n);
+			right->count = (unsigned char)(right->count - n);
+		}
+
+		//从左兄弟 left 匀 n 个元素给 right
+		void __move_right(node_pointer left, node_pointer right, int n) {
+			node_pointer parent = left->parent;
+			int p = left->position;
+			int c = left->count;
+			relocate(right->value(n), right->value(0), right->count);
+			relocate(right->value(n - 1), parent->value(p), 1);
+			relocate(right->value(0), left->value(c - n + 1), n - 1);
+			relocate(parent->value(p), left->value(c - n), 1);
+			if (!right->leaf) {
+				for (int j = right->count; j >= 0; --j)
+					right->set_child(j + n, right->child(j));
+				for (int j = 0; j < n; ++j)
+					right->set_child(j, left->child(c - n + 1 + j));
+			}
+			left->count = (unsigned char)(c - n);
+			right->count = (unsigned char)(right->count + n);
+		}
+
+		void __erase_subtree(node_pointer x) {
+			if (!x->leaf) {
+				for (int i = 0; i <= x->count; ++i)
+					__erase_subtree(x->child(i));
+			}
+			destroy_values(x);
+			free_node(x);
+		}
+
+		void __copy_from(const self& x) {
+			for (const_iterator it = x.begin(); it != x.end(); ++it)
+				__append(*it);
+		}
+	};
+
+}// end of namespace detail
+}// end of namespace lfp
+
+#endif // !_STL_BTREE_H_
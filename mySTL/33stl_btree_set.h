@@ -0,0 +1,125 @@
+/*
+ *btree_set实现
+ *
+ *btree_set使用B树（32stl_btree.h）作为底层容器，接口与set相同
+ *B树的节点存放多个元素，对小的键值查找更快、内存更省，代价是任何插入、删除都使所有迭代器失效
+ *btree_set使用B树的insert_unique来插入元素，btree_multiset使用 insert_equal
+ */
+
+#ifndef _STL_BTREE_SET_H_
+#define _STL_BTREE_SET_H_
+
+#include "1stl_alloctor.h"
+#include "2stl_algobase.h"		//identity less
+#include "32stl_btree.h"
+#include <utility>			//forward
+
+namespace lfp {
+
+	//省缺使用递增排序(less)
+	template<class Key, class Compare = std::less<Key>, class Alloc = alloc>
+	class btree_set {
+	public:
+		typedef Key			key_type;
+		typedef Key			value_type;
+		typedef Compare		key_compare;
+		typedef Compare		value_compare;
+	private:
+		//注意：以下第一、第二参数分别为键值和实值型别，对于set键值和实值型别相同
+		typedef detail::btree<key_type, value_type, identity<value_type>, key_compare, Alloc> rep_type;
+		typedef typename rep_type::iterator rep_iterator;
+
+		rep_type t;		//底层容器采用 B树
+
+	public:
+		/* 注意：以下将btree_set的iterator定义为B树的const_iterator，因为set的键值不可以改变 */
+		typedef typename rep_type::const_iterator		iterator;
+		typedef typename rep_type::const_iterator		const_iterator;
+		typedef typename rep_type::const_pointer		pointer;
+		typedef typename rep_type::const_pointer		const_pointer;
+		typedef typename rep_type::const_reference		reference;
+		typedef typename rep_type::const_reference		const_reference;
+		typedef typename rep_type::size_type			size_type;
+		typedef typename rep_type::difference_type		difference_type;
+		//typedef typename rep_type::const_reverse_iterator	reverse_iterator;
+
+		btree_set() : t(Compare()) { }
+		explicit btree_set(const Compare& comp) : t(comp) { }
+		template<class InputIterator>
+		btree_set(InputIterator first, InputIterator last) : t(Compare()) {
+			t.insert_unique(first, last);
+		}
+		//[first, last) 已按键值严格递增排序，线性时间建立
+		template<class ForwardIterator>
+		btree_set(sorted_unique_t, ForwardIterator first, ForwardIterator last) : t(Compare()) {
+			t.assign_sorted(first, last);
+		}
+		btree_set(const btree_set<Key, Compare, Alloc>& x) : t(x.t) { }
+
+		btree_set<Key, Compare, Alloc>& operator=(const btree_set<Key, Compare, Alloc>& x) {
+			t = x.t;
+			return *this;
+		}
+
+		/* 以下的所有操作B树已经提供，只需要传递调用即可 */
+
+		//accessors:
+		iterator begin() const { return t.begin(); }
+		iterator end() const { return t.end(); }
+		key_compare key_comp() const { return t.key_comp(); }
+		value_compare value_comp() const { return t.key_comp(); }
+//		reverse_iterator rbegin() const { return t.rbegin(); }
+//		reverse_iterator rend() const { return t.rend(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+		void swap(btree_set<Key, Compare, Alloc>& x) { t.swap(x.t); }
+
+		//insert
+		std::pair<iterator, bool> insert(const value_type& x) {
+			std::pair<rep_iterator, bool> p = t.insert_unique(x);
+			return std::pair<iterator, bool>(p.first, p.second);
+		}
+		//pos 为提示：新元素应紧邻 pos 之前，例如按键值递增的顺序以 end() 为提示插入，均摊常数时间
+		iterator insert(const_iterator pos, const value_type& x) {
+			return t.insert_unique(pos, x);
+		}
+		template<class... Args>
+		std::pair<iterator, bool> emplace(Args&&... args) {
+			std::pair<rep_iterator, bool> p = t.emplace_unique(std::forward<Args>(args)...);
+			return std::pair<iterator, bool>(p.first, p.second);
+		}
+		template<class... Args>
+		iterator emplace_hint(const_iterator pos, Args&&... args) {
+			return t.emplace_hint_unique(pos, std::forward<Args>(args)...);
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			t.insert_unique(first, last);
+		}
+
+		//erase
+		void erase(iterator pos) {
+			t.erase(pos);
+		}
+		size_type erase(const key_type& x) {
+			return t.erase(x);
+		}
+		void erase(iterator first, iterator last) {
+			t.erase(first, last);
+		}
+		void clear() { t.clear(); }
+
+		//btree_set operations
+		iterator find(const key_type& x) const { return t.find(x); }
+		size_type count(const key_type& x) const { return t.count(x); }
+		iterator lower_bound(const key_type& x) const { return (iterator)t.lower_bound(x); }
+		iterator upper_bound(const key_type& x) const { return (iterator)t.upper_bound(x); }
+
+		/* 返回元素 x 的区间 */
+		std::pair<iterator, iterator> equal_range(const key_type& x) const { return t.equal_range(x); }
+	};
+
+}// end of namespace lfp
+
+#endif	//! _STL_BTREE_SET_H_
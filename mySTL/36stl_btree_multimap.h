@@ -0,0 +1,150 @@
+/*
+ *btree_multimap实现
+ *
+ *btree_multimap与btree_map的唯一区别是允许键值重复，使用B树的insert_equal进行插入
+ *任何插入、删除都使所有迭代器失效
+ */
+
+#ifndef _STL_BTREE_MULTIMAP_H_
+#define _STL_BTREE_MULTIMAP_H_
+
+#include "1stl_alloctor.h"
+#include "2stl_algobase.h"	//select1st less
+#include "32stl_btree.h"
+#include <utility>			//pair forward
+
+namespace lfp {
+
+	//以下Key为键值型别，T为实值型别，省缺使用递增排序(less)
+	template<class Key, class T, class Compare = std::less<Key>, class Alloc = alloc>
+	class btree_multimap {
+	public:
+		typedef Key							key_type;		//键值型别
+		typedef T							data_type;		//实值型别
+		typedef T							mapped_type;
+		typedef std::pair<const Key, T>		value_type;		//btree_multimap 的元素型别
+		typedef Compare						key_compare;	//键值比较仿函数
+
+		//以下定义一个仿函数，其作用是实现元素比较函数（通过调用键值比较函数实现）
+		class value_compare : public binary_function<value_type, value_type, bool>
+		{
+		protected:
+			friend class btree_multimap<Key, T, Compare, Alloc>;
+
+			Compare comp;
+			value_compare(Compare c) : comp(c) { }
+		public:
+			bool operator()(const value_type& x, const value_type& y) const {
+				return comp(x.first, y.first);
+			}
+		};
+	private:
+		//以下第一、第二参数分别为键值和元素型别。键值为pair第一参数，实值为pair，第二参数
+		typedef detail::btree<key_type, value_type, select1st<value_type>, key_compare, Alloc> rep_type;
+
+		rep_type t;
+	public:
+		/* 以下并不像set将iterator定义为B树的const_iterator，因为multimap可通过iterator改变元素实值 */
+		typedef typename rep_type::iterator				iterator;
+		typedef typename rep_type::const_iterator		const_iterator;
+		typedef typename rep_type::pointer				pointer;
+		typedef typename rep_type::const_pointer		const_pointer;
+		typedef typename rep_type::reference			reference;
+		typedef typename rep_type::const_reference		const_reference;
+		typedef typename rep_type::size_type			size_type;
+		typedef typename rep_type::difference_type		difference_type;
+		//typedef typename rep_type::reverse_iterator	reverse_iterator;
+
+		btree_multimap() : t(Compare()) { }
+		explicit btree_multimap(const Compare& comp) : t(comp) { }
+		template<class InputIterator>
+		btree_multimap(InputIterator first, InputIterator last) : t(Compare()) {
+			t.insert_equal(first, last);
+		}
+		//[first, last) 已按键值非递减排序，线性时间建立
+		template<class ForwardIterator>
+		btree_multimap(sorted_equivalent_t, ForwardIterator first, ForwardIterator last) : t(Compare()) {
+			t.assign_sorted(first, last);
+		}
+		btree_multimap(const btree_multimap<Key, T, Compare, Alloc>& x) : t(x.t) { }
+
+		btree_multimap<Key, T, Compare, Alloc>& operator=(const btree_multimap<Key, T, Compare, Alloc>& x) {
+			t = x.t;
+			return *this;
+		}
+
+		//以下所有的行为都转调用 B树 的行为
+		key_compare key_comp() const { return t.key_comp(); }
+		value_compare value_comp() const { return value_compare(t.key_comp()); }
+
+		iterator begin() { return t.begin(); }
+		const_iterator begin() const { return t.begin(); }
+		iterator end() { return t.end(); }
+		const_iterator end() const { return t.end(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+
+		//注意以下 下标操作符，写法虽然有些复杂，但是很巧妙
+		T& operator[](const key_type& k) {
+			return (*(insert(value_type(k, T())))).second;
+
+			/* insert(value_type(k, T()))返回的是一个 iterator */
+			/* 其第一元素是指向成功插入或发生冲突的map元素（pair<Key, T>）的iterator */
+			/* 所以 *((insert(value_type(k, T()))).first) 提领其第一元素，得到一个pair<Key, T> */
+			/* 最终 (*((insert(value_type(k, T()))).first)).second 得到这个 pair<Key, T> 的T */
+		}
+
+		void swap(btree_multimap<Key, T, Compare, Alloc>& x) { t.swap(x.t); }
+
+		//insert/erase
+		iterator insert(const value_type& x) {
+			return t.insert_equal(x);
+		}
+		//pos 为提示：新元素应紧邻 pos 之前，例如按键值递增的顺序以 end() 为提示插入，均摊常数时间
+		iterator insert(const_iterator pos, const value_type& x) {
+			return t.insert_equal(pos, x);
+		}
+		template<class... Args>
+		iterator emplace(Args&&... args) {
+			return t.emplace_equal(std::forward<Args>(args)...);
+		}
+		template<class... Args>
+		iterator emplace_hint(const_iterator pos, Args&&... args) {
+			return t.emplace_hint_equal(pos, std::forward<Args>(args)...);
+		}
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			t.insert_equal(first, last);
+		}
+	
+		void erase(iterator pos) { t.erase(pos); }
+		size_type erase(const key_type& x) { return t.erase(x); }
+		void erase(iterator first, iterator last) { t.erase(first, last); }
+		void clear() { t.clear(); }
+
+		//btree_multimap operations
+		iterator find(const key_type& k) { return t.find(k); }
+		const_iterator find(const key_type& k) const { return t.find(k); }
+		size_type count(const key_type& k) const { return t.count(k); }
+
+		iterator lower_bound(const key_type& k) { return t.lower_bound(k); }
+		const_iterator lower_bound(const key_type& k) const {
+			return t.lower_bound(k);
+		}
+		iterator upper_bound(const key_type& k) { return t.upper_bound(k); }
+		const_iterator upper_bound(const key_type& k) const {
+			return t.upper_bound(k);
+		}
+
+		std::pair<iterator, iterator> equal_range(const key_type& x) {
+			return t.equal_range(x);
+		}
+		std::pair<const_iterator, const_iterator> equal_range(const key_type& x) const {
+			return t.equal_range(x);
+		}
+	};
+
+} // end of namespace lfp
+
+#endif	//! _STL_BTREE_MULTIMAP_H_
@@ -0,0 +1,323 @@
+/*
+ *flat_tree实现，flat_set、flat_multiset、flat_map、flat_multimap 的底层容器
+ *
+ *元素按键值有序地存放在一个 vector 中，以 2stl_algobase.h 的 lower_bound、upper_bound 二分查找。
+ *与红黑树相比没有任何节点指针，元素紧密排列，查找和遍历都只访问连续的内存；
+ *代价是单个元素的插入、删除需要搬移其后的所有元素，为 O(n)
+ *
+ *适合建立一次、之后大量查找的场合。建立时应使用区间插入 insert(first, last)：
+ *新元素先全部追加到尾端，排序后与原有元素合并一次，总共 O(n + m log m)，而不是每个元素各搬移一次
+ *
+ *任何插入、删除都可能使所有的迭代器失效。sequence()、data() 可以直接取得底层的有序连续存储
+ */
+
+#ifndef _STL_FLAT_TREE_H_
+#define _STL_FLAT_TREE_H_
+
+#include "1stl_alloctor.h"		//空间配置器
+#include "2stl_algobase.h"		//for lower_bound upper_bound
+#include "4stl_vector.h"
+#include <utility>				//for pair forward
+
+namespace lfp {
+namespace detail {
+
+	//以下两个仿函数把元素与键值的比较转为键值之间的比较，分别供 lower_bound、upper_bound 使用
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	struct __flat_value_less_key {
+		Compare comp;
+		__flat_value_less_key(const Compare& c) : comp(c) { }
+		bool operator()(const Value& x, const Key& k) const { return comp(KeyOfValue()(x), k); }
+	};
+	template<class Key, class Value, class KeyOfValue, class Compare>
+	struct __flat_key_less_value {
+		Compare comp;
+		__flat_key_less_value(const Compare& c) : comp(c) { }
+		bool operator()(const Key& k, const Value& x) const { return comp(k, KeyOfValue()(x)); }
+	};
+
+
+	template<class Key, class Value, class KeyOfValue, class Compare, class Alloc = alloc>
+	class flat_tree {
+	public:
+		typedef Key								key_type;
+		typedef Value							value_type;
+		typedef value_type*						pointer;
+		typedef const value_type*				const_pointer;
+		typedef value_type&						reference;
+		typedef const value_type&				const_reference;
+		typedef size_t							size_type;
+		typedef ptrdiff_t						difference_type;
+		typedef vector<value_type, Alloc>		sequence_type;
+		typedef typename sequence_type::iterator			iterator;
+		typedef typename sequence_type::const_iterator		const_iterator;
+
+	protected:
+		typedef flat_tree<Key, Value, KeyOfValue, Compare, Alloc> self;
+
+		sequence_type c;			//按键值有序存放的元素
+		Compare key_compare;
+
+		const Key& key(const value_type& x) const { return KeyOfValue()(x); }
+		bool value_less(const value_type& x, const value_type& y) const { return key_compare(key(x), key(y)); }
+		iterator __mutable(const_iterator it) { return c.begin() + (it - c.begin()); }
+
+	public:
+		flat_tree(const Compare& comp = Compare()) : key_compare(comp) { }
+		flat_tree(const self& x) : c(x.c.begin(), x.c.end()), key_compare(x.key_compare) { }
+
+		self& operator=(const self& x) {
+			if (this != &x) {
+				sequence_type tmp(x.c.begin(), x.c.end());
+				c.swap(tmp);
+				key_compare = x.key_compare;
+			}
+			return *this;
+		}
+
+	public:
+		Compare key_comp() const { return key_compare; }
+		iterator begin() { return c.begin(); }
+		const_iterator begin() const { return c.begin(); }
+		iterator end() { return c.end(); }
+		const_iterator end() const { return c.end(); }
+		bool empty() const { return c.size() == 0; }
+		size_type size() const { return c.size(); }
+		size_type max_size() const { return size_type(-1) / sizeof(value_type); }
+		size_type capacity() const { return c.capacity(); }
+		void reserve(size_type n) { c.reserve(n); }
+
+		//底层的有序连续存储，不得经由它改变元素的次序
+		const sequence_type& sequence() const { return c; }
+		const value_type* data() const { return c.begin(); }
+
+		void swap(self& x) {
+			c.swap(x.c);
+			lfp::swap(key_compare, x.key_compare);
+		}
+		void clear() { c.clear(); }
+
+	public:
+		//insert/erase
+		std::pair<iterator, bool> insert_unique(const value_type& v) {
+			iterator pos = lower_bound(key(v));
+			if (pos != end() && !key_compare(key(v), key(*pos)))
+				return std::pair<iterator, bool>(pos, false);
+			return std::pair<iterator, bool>(__insert(pos, v), true);
+		}
+		//键值相同的元素，新元素放在最后
+		iterator insert_equal(const value_type& v) {
+			return __insert(upper_bound(key(v)), v);
+		}
+		//pos 为提示：新元素应紧邻 pos 之前。提示正确时省去查找，但搬移元素仍是 O(n)
+		iterator insert_unique(const_iterator pos, const value_type& v) {
+			if ((pos == end() || key_compare(key(v), key(*pos))) &&
+				(pos == begin() || key_compare(key(*(pos - 1)), key(v))))
+				return __insert(__mutable(pos), v);
+			return insert_unique(v).first;
+		}
+		iterator insert_equal(const_iterator pos, const value_type& v) {
+			if ((pos == end() || !key_compare(key(*pos), key(v))) &&
+				(pos == begin() || !key_compare(key(v), key(*(pos - 1)))))
+				return __insert(__mutable(pos), v);
+			return insert_equal(v);
+		}
+		template<class... Args>
+		std::pair<iterator, bool> emplace_unique(Args&&... args) {
+			return insert_unique(value_type(std::forward<Args>(args)...));
+		}
+		template<class... Args>
+		iterator emplace_equal(Args&&... args) {
+			return insert_equal(value_type(std::forward<Args>(args)...));
+		}
+		template<class... Args>
+		iterator emplace_hint_unique(const_iterator pos, Args&&... args) {
+			return insert_unique(pos, value_type(std::forward<Args>(args)...));
+		}
+		template<class... Args>
+		iterator emplace_hint_equal(const_iterator pos, Args&&... args) {
+			return insert_equal(pos, value_type(std::forward<Args>(args)...));
+		}
+
+		//批量插入：全部追加到尾端，稳定排序后与原有元素合并一次。
+		//键值重复时保留先出现的元素（原有元素优先于新元素，新元素之间按输入的次序）
+		template<class InputIterator>
+		void insert_unique(InputIterator first, InputIterator last) {
+			size_type n = c.size();
+			for (; first != last; ++first)
+				c.push_back(*first);
+			__sort_and_merge(n, true);
+		}
+		template<class InputIterator>
+		void insert_equal(InputIterator first, InputIterator last) {
+			size_type n = c.size();
+			for (; first != last; ++first)
+				c.push_back(*first);
+			__sort_and_merge(n, false);
+		}
+		//以 [first, last) 取代原有内容，调用者保证其已排序，不做任何比较
+		template<class InputIterator>
+		void assign_sorted(InputIterator first, InputIterator last) {
+			sequence_type tmp;
+			for (; first != last; ++first)
+				tmp.push_back(*first);
+			c.swap(tmp);
+		}
+
+		iterator erase(const_iterator pos) { return c.erase(__mutable(pos)); }
+		size_type erase(const key_type& k) {
+			std::pair<iterator, iterator> p = equal_range(k);
+			size_type n = p.second - p.first;
+			if (n > 0)
+				c.erase(p.first, p.second);
+			return n;
+		}
+		iterator erase(const_iterator first, const_iterator last) {
+			return c.erase(__mutable(first), __mutable(last));
+		}
+
+	public:
+		//set/map operations
+		iterator find(const key_type& k) {
+			iterator it = lower_bound(k);
+			return (it == end() || key_compare(k, key(*it))) ? end() : it;
+		}
+		const_iterator find(const key_type& k) const {
+			const_iterator it = lower_bound(k);
+			return (it == end() || key_compare(k, key(*it))) ? end() : it;
+		}
+		size_type count(const key_type& k) const {
+			std::pair<const_iterator, const_iterator> p = equal_range(k);
+			return p.second - p.first;
+		}
+		iterator lower_bound(const key_type& k) {
+			return lfp::lower_bound(c.begin(), c.end(), k, __flat_value_less_key<Key, Value, KeyOfValue, Compare>(key_compare));
+		}
+		const_iterator lower_bound(const key_type& k) const {
+			return lfp::lower_bound(c.begin(), c.end(), k, __flat_value_less_key<Key, Value, KeyOfValue, Compare>(key_compare));
+		}
+		iterator upper_bound(const key_type& k) {
+			return lfp::upper_bound(c.begin(), c.end(), k, __flat_key_less_value<Key, Value, KeyOfValue, Compare>(key_compare));
+		}
+		const_iterator upper_bound(const key_type& k) const {
+			return lfp::upper_bound(c.begin(), c.end(), k, __flat_key_less_value<Key, Value, KeyOfValue, Compare>(key_compare));
+		}
+		std::pair<iterator, iterator> equal_range(const key_type& k) {
+			iterator first = lower_bound(k);
+			return std::pair<iterator, iterator>(first, lfp::upper_bound(first, c.end(), k,
+				__flat_key_less_value<Key, Value, KeyOfValue, Compare>(key_compare)));
+		}
+		std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+			const_iterator first = lower_bound(k);
+			return std::pair<const_iterator, const_iterator>(first, lfp::upper_bound(first, c.end(), k,
+				__flat_key_less_value<Key, Value, KeyOfValue, Compare>(key_compare)));
+		}
+
+	protected:
+		//vector::insert 不传回迭代器，插入后以下标重新取得
+		iterator __insert(iterator pos, const value_type& v) {
+			size_type i = pos - c.begin();
+			c.insert(pos, v);
+			return c.begin() + i;
+		}
+
+		//[first, last) 的稳定插入排序，用于短区间
+		void __insertion_sort(iterator first, iterator last) {
+			if (first == last)
+				return;
+			for (iterator i = first + 1; i != last; ++i) {
+				value_type tmp = *i;
+				iterator j = i;
+				for (; j != first && value_less(tmp, *(j - 1)); --j)
+					*j = *(j - 1);
+				*j = tmp;
+			}
+		}
+
+		//[first, first + n) 的稳定归并排序，buf 至少可以容纳 n / 2 个元素
+		void __merge_sort(iterator first, size_type n, iterator buf) {
+			if (n <= 16) {
+				__insertion_sort(first, first + n);
+				return;
+			}
+			size_type half = n / 2;
+			iterator mid = first + half, last = first + n;
+			__merge_sort(first, half, buf);
+			__merge_sort(mid, n - half, buf);
+			if (!value_less(*mid, *(mid - 1)))		//两半已经有序
+				return;
+			//前一半移到 buf，再与后一半合并回原处。写入位置永远不会超过后一半的读取位置
+			iterator buf_last = lfp::copy(first, mid, buf);
+			iterator i = buf, j = mid, out = first;
+			while (i != buf_last && j != last) {
+				if (value_less(*j, *i))
+					*out++ = *j++;
+				else
+					*out++ = *i++;
+			}
+			lfp::copy(i, buf_last, out);
+		}
+
+		//[0, n) 为原有的有序元素，[n, size()) 为新追加的元素。排序新元素后与原有元素合并
+		void __sort_and_merge(size_type n, bool unique) {
+			iterator first = c.begin() + n, last = c.end();
+			if (first == last)
+				return;
+			//新元素本身已有序时（例如按键值递增的顺序建立）不必排序
+			bool sorted = true;
+			for (iterator it = first + 1; it != last && sorted; ++it)
+				sorted = !value_less(*it, *(it - 1));
+			if (!sorted) {
+				sequence_type buf(first, first + (last - first + 1) / 2);
+				__merge_sort(first, last - first, buf.begin());
+			}
+			if (unique) {
+				last = __unique(first, last);
+				if (n > 0)
+					last = __remove_existing(first, last);
+				c.erase(last, c.end());
+				first = c.begin() + n;
+				if (first == last)
+					return;
+			}
+			if (n == 0 || !value_less(*first, *(first - 1)))	//新元素都排在原有元素之后
+				return;
+
+			//新元素移到临时空间，从尾端开始向前合并，比新元素小的原有元素不必移动。
+			//键值相同时原有元素在前
+			sequence_type buf(first, last);
+			difference_type i = n - 1, j = buf.size() - 1, out = c.size() - 1;
+			while (j >= 0) {
+				if (i >= 0 && value_less(buf[j], c[i]))
+					c[out--] = c[i--];
+				else
+					c[out--] = buf[j--];
+			}
+		}
+
+		//有序的新元素 [first, last) 中去除键值已在原有元素中出现的，传回新的结尾
+		iterator __remove_existing(iterator first, iterator last) {
+			iterator p = c.begin(), out = first;
+			for (iterator it = first; it != last; ++it) {
+				p = lfp::lower_bound(p, first, key(*it), __flat_value_less_key<Key, Value, KeyOfValue, Compare>(key_compare));
+				if (p == first || value_less(*it, *p))
+					*out++ = *it;
+			}
+			return out;
+		}
+
+		//去除有序区间中键值重复的元素，保留每组的第一个，传回新的结尾
+		iterator __unique(iterator first, iterator last) {
+			iterator out = first;
+			for (iterator it = first + 1; it != last; ++it) {
+				if (value_less(*out, *it))
+					*++out = *it;
+			}
+			return out + 1;
+		}
+	};
+
+}// end of namespace detail
+}// end of namespace lfp
+
+#endif // !_STL_FLAT_TREE_H_
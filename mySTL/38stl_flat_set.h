@@ -0,0 +1,133 @@
+/*
+ *flat_set实现
+ *
+ *flat_set使用flat_tree（37stl_flat_tree.h，有序的 vector）作为底层容器，接口与set相同
+ *查找为连续内存上的二分查找，没有节点指针的开销；单个元素的插入、删除为 O(n)，
+ *应以区间插入 insert(first, last) 批量建立。任何插入、删除都可能使所有迭代器失效
+ *flat_set使用flat_tree的insert_unique来插入元素，flat_multiset使用 insert_equal
+ */
+
+#ifndef _STL_FLAT_SET_H_
+#define _STL_FLAT_SET_H_
+
+#include "1stl_alloctor.h"
+#include "2stl_algobase.h"		//identity less
+#include "37stl_flat_tree.h"
+#include <utility>			//forward
+
+namespace lfp {
+
+	//省缺使用递增排序(less)
+	template<class Key, class Compare = std::less<Key>, class Alloc = alloc>
+	class flat_set {
+	public:
+		typedef Key			key_type;
+		typedef Key			value_type;
+		typedef Compare		key_compare;
+		typedef Compare		value_compare;
+	private:
+		//注意：以下第一、第二参数分别为键值和实值型别，对于set键值和实值型别相同
+		typedef detail::flat_tree<key_type, value_type, identity<value_type>, key_compare, Alloc> rep_type;
+		typedef typename rep_type::iterator rep_iterator;
+
+		rep_type t;		//底层容器采用有序的 vector
+
+	public:
+		/* 注意：以下将flat_set的iterator定义为flat_tree的const_iterator，因为set的键值不可以改变 */
+		typedef typename rep_type::const_iterator		iterator;
+		typedef typename rep_type::const_iterator		const_iterator;
+		typedef typename rep_type::const_pointer		pointer;
+		typedef typename rep_type::const_pointer		const_pointer;
+		typedef typename rep_type::const_reference		reference;
+		typedef typename rep_type::const_reference		const_reference;
+		typedef typename rep_type::size_type			size_type;
+		typedef typename rep_type::difference_type		difference_type;
+		typedef typename rep_type::sequence_type		sequence_type;
+		//typedef typename rep_type::const_reverse_iterator	reverse_iterator;
+
+		flat_set() : t(Compare()) { }
+		explicit flat_set(const Compare& comp) : t(comp) { }
+		template<class InputIterator>
+		flat_set(InputIterator first, InputIterator last) : t(Compare()) {
+			t.insert_unique(first, last);
+		}
+		//[first, last) 已按键值严格递增排序，直接复制，线性时间建立
+		template<class ForwardIterator>
+		flat_set(sorted_unique_t, ForwardIterator first, ForwardIterator last) : t(Compare()) {
+			t.assign_sorted(first, last);
+		}
+		flat_set(const flat_set<Key, Compare, Alloc>& x) : t(x.t) { }
+
+		flat_set<Key, Compare, Alloc>& operator=(const flat_set<Key, Compare, Alloc>& x) {
+			t = x.t;
+			return *this;
+		}
+
+		/* 以下的所有操作flat_tree已经提供，只需要传递调用即可 */
+
+		//accessors:
+		iterator begin() const { return t.begin(); }
+		iterator end() const { return t.end(); }
+		key_compare key_comp() const { return t.key_comp(); }
+		value_compare value_comp() const { return t.key_comp(); }
+//		reverse_iterator rbegin() const { return t.rbegin(); }
+//		reverse_iterator rend() const { return t.rend(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+		size_type capacity() const { return t.capacity(); }
+		void reserve(size_type n) { t.reserve(n); }
+		//底层按键值有序的连续存储
+		const sequence_type& sequence() const { return t.sequence(); }
+		const value_type* data() const { return t.data(); }
+		void swap(flat_set<Key, Compare, Alloc>& x) { t.swap(x.t); }
+
+		//insert
+		std::pair<iterator, bool> insert(const value_type& x) {
+			std::pair<rep_iterator, bool> p = t.insert_unique(x);
+			return std::pair<iterator, bool>(p.first, p.second);
+		}
+		//pos 为提示：新元素应紧邻 pos 之前，例如按键值递增的顺序以 end() 为提示插入，均摊常数时间
+		iterator insert(const_iterator pos, const value_type& x) {
+			return t.insert_unique(pos, x);
+		}
+		template<class... Args>
+		std::pair<iterator, bool> emplace(Args&&... args) {
+			std::pair<rep_iterator, bool> p = t.emplace_unique(std::forward<Args>(args)...);
+			return std::pair<iterator, bool>(p.first, p.second);
+		}
+		template<class... Args>
+		iterator emplace_hint(const_iterator pos, Args&&... args) {
+			return t.emplace_hint_unique(pos, std::forward<Args>(args)...);
+		}
+		//批量插入：全部追加到尾端后排序，再与原有元素合并一次
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			t.insert_unique(first, last);
+		}
+
+		//erase
+		void erase(iterator pos) {
+			t.erase(pos);
+		}
+		size_type erase(const key_type& x) {
+			return t.erase(x);
+		}
+		void erase(iterator first, iterator last) {
+			t.erase(first, last);
+		}
+		void clear() { t.clear(); }
+
+		//flat_set operations
+		iterator find(const key_type& x) const { return t.find(x); }
+		size_type count(const key_type& x) const { return t.count(x); }
+		iterator lower_bound(const key_type& x) const { return (iterator)t.lower_bound(x); }
+		iterator upper_bound(const key_type& x) const { return (iterator)t.upper_bound(x); }
+
+		/* 返回元素 x 的区间 */
+		std::pair<iterator, iterator> equal_range(const key_type& x) const { return t.equal_range(x); }
+	};
+
+}// end of namespace lfp
+
+#endif	//! _STL_FLAT_SET_H_
@@ -0,0 +1,160 @@
+/*
+ *flat_map实现
+ *
+ *flat_map使用flat_tree（37stl_flat_tree.h，有序的 vector）作为底层容器，接口与map相同
+ *查找为连续内存上的二分查找，没有节点指针的开销；单个元素的插入、删除为 O(n)，
+ *应以区间插入 insert(first, last) 批量建立。任何插入、删除都可能使所有迭代器失效
+ *flat_map使用flat_tree的 insert_unique 来插入元素，flat_multimap使用 insert_equal
+ *
+ *元素是一个pair，它通过投射函数select1st返回第一参数作为Key。排序和合并需要对元素赋值，
+ *因此元素型别为 pair<Key, T> 而不是 pair<const Key, T>，不得经由迭代器改变键值
+ */
+
+#ifndef _STL_FLAT_MAP_H_
+#define _STL_FLAT_MAP_H_
+
+#include "1stl_alloctor.h"
+#include "2stl_algobase.h"	//select1st less
+#include "37stl_flat_tree.h"
+#include <utility>			//pair forward
+
+namespace lfp {
+
+	//以下Key为键值型别，T为实值型别，省缺使用递增排序(less)
+	template<class Key, class T, class Compare = std::less<Key>, class Alloc = alloc>
+	class flat_map {
+	public:
+		typedef Key							key_type;		//键值型别
+		typedef T							data_type;		//实值型别
+		typedef T							mapped_type;
+		typedef std::pair<Key, T>			value_type;		//flat_map 的元素型别
+		typedef Compare						key_compare;	//键值比较仿函数
+
+		//以下定义一个仿函数，其作用是实现元素比较函数（通过调用键值比较函数实现）
+		class value_compare : public binary_function<value_type, value_type, bool>
+		{
+		protected:
+			friend class flat_map<Key, T, Compare, Alloc>;
+
+			Compare comp;
+			value_compare(Compare c) : comp(c) { }
+		public:
+			bool operator()(const value_type& x, const value_type& y) const {
+				return comp(x.first, y.first);
+			}
+		};
+	private:
+		//以下第一、第二参数分别为键值和元素型别。键值为pair第一参数，实值为pair，第二参数
+		typedef detail::flat_tree<key_type, value_type, select1st<value_type>, key_compare, Alloc> rep_type;
+
+		rep_type t;
+	public:
+		/* 以下并不像set将iterator定义为flat_tree的const_iterator，因为map可通过iterator改变元素实值 */
+		typedef typename rep_type::iterator				iterator;
+		typedef typename rep_type::const_iterator		const_iterator;
+		typedef typename rep_type::pointer				pointer;
+		typedef typename rep_type::const_pointer		const_pointer;
+		typedef typename rep_type::reference			reference;
+		typedef typename rep_type::const_reference		const_reference;
+		typedef typename rep_type::size_type			size_type;
+		typedef typename rep_type::difference_type		difference_type;
+		typedef typename rep_type::sequence_type		sequence_type;
+		//typedef typename rep_type::reverse_iterator	reverse_iterator;
+
+		flat_map() : t(Compare()) { }
+		explicit flat_map(const Compare& comp) : t(comp) { }
+		template<class InputIterator>
+		flat_map(InputIterator first, InputIterator last) : t(Compare()) {
+			t.insert_unique(first, last);
+		}
+		//[first, last) 已按键值严格递增排序，直接复制，线性时间建立
+		template<class ForwardIterator>
+		flat_map(sorted_unique_t, ForwardIterator first, ForwardIterator last) : t(Compare()) {
+			t.assign_sorted(first, last);
+		}
+		flat_map(const flat_map<Key, T, Compare, Alloc>& x) : t(x.t) { }
+
+		flat_map<Key, T, Compare, Alloc>& operator=(const flat_map<Key, T, Compare, Alloc>& x) {
+			t = x.t;
+			return *this;
+		}
+
+		//以下所有的行为都转调用 flat_tree 的行为
+		key_compare key_comp() const { return t.key_comp(); }
+		value_compare value_comp() const { return value_compare(t.key_comp()); }
+
+		iterator begin() { return t.begin(); }
+		const_iterator begin() const { return t.begin(); }
+		iterator end() { return t.end(); }
+		const_iterator end() const { return t.end(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+		size_type capacity() const { return t.capacity(); }
+		void reserve(size_type n) { t.reserve(n); }
+		//底层按键值有序的连续存储
+		const sequence_type& sequence() const { return t.sequence(); }
+		const value_type* data() const { return t.data(); }
+
+		//先以 lower_bound 找到位置，键值不存在时以之为提示插入，只需查找一次
+		T& operator[](const key_type& k) {
+			iterator it = lower_bound(k);
+			if (it == end() || key_comp()(k, (*it).first))
+				it = insert(it, value_type(k, T()));
+			return (*it).second;
+		}
+
+		void swap(flat_map<Key, T, Compare, Alloc>& x) { t.swap(x.t); }
+
+		//insert/erase
+		std::pair<iterator, bool> insert(const value_type& x) {
+			return t.insert_unique(x);
+		}
+		//pos 为提示：新元素应紧邻 pos 之前，例如按键值递增的顺序以 end() 为提示插入，均摊常数时间
+		iterator insert(const_iterator pos, const value_type& x) {
+			return t.insert_unique(pos, x);
+		}
+		template<class... Args>
+		std::pair<iterator, bool> emplace(Args&&... args) {
+			return t.emplace_unique(std::forward<Args>(args)...);
+		}
+		template<class... Args>
+		iterator emplace_hint(const_iterator pos, Args&&... args) {
+			return t.emplace_hint_unique(pos, std::forward<Args>(args)...);
+		}
+		//批量插入：全部追加到尾端后排序，再与原有元素合并一次
+		template<class InputIterator>
+		void insert(InputIterator first, InputIterator last) {
+			t.insert_unique(first, last);
+		}
+	
+		void erase(iterator pos) { t.erase(pos); }
+		size_type erase(const key_type& x) { return t.erase(x); }
+		void erase(iterator first, iterator last) { t.erase(first, last); }
+		void clear() { t.clear(); }
+
+		//flat_map operations
+		iterator find(const key_type& k) { return t.find(k); }
+		const_iterator find(const key_type& k) const { return t.find(k); }
+		size_type count(const key_type& k) const { return t.count(k); }
+
+		iterator lower_bound(const key_type& k) { return t.lower_bound(k); }
+		const_iterator lower_bound(const key_type& k) const {
+			return t.lower_bound(k);
+		}
+		iterator upper_bound(const key_type& k) { return t.upper_bound(k); }
+		const_iterator upper_bound(const key_type& k) const {
+			return t.upper_bound(k);
+		}
+
+		std::pair<iterator, iterator> equal_range(const key_type& x) {
+			return t.equal_range(x);
+		}
+		std::pair<const_iterator, const_iterator> equal_range(const key_type& x) const {
+			return t.equal_range(x);
+		}
+	};
+
+} // end of namespace lfp
+
+#endif	//! _STL_FLAT_MAP_H_
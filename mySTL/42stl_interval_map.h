@@ -0,0 +1,231 @@
+/*
+ *interval_map实现
+ *
+ *interval_map 以闭区间 [low, high] 为键值、T 为实值，允许区间重叠和重复（同 multimap），底层为 rb_tree：
+ *	·元素按 (low, high) 的字典序排列
+ *	·每个节点通过 rb_tree 的 Augment 参数额外维护其子树中所有区间 high 的最大值（__max_high），
+ *	 旋转、插入、删除时由 rb_tree 自动更新
+ *
+ *查询：
+ *	·overlapping(lo, hi, f)：对每个与 [lo, hi] 相交的区间（low <= hi 且 high >= lo）按序调用 f(元素)
+ *	·stabbing(p, f)：对每个包含点 p 的区间按序调用 f(元素)，即 overlapping(p, p, f)
+ *	自根节点往下搜索：子树的 __max_high 小于 lo 时整棵剪掉；节点的 low 大于 hi 时不必再看它和它的右子树。
+ *	除边界上的 O(log n) 个节点外，访问到的节点都是某个结果的祖先。结果在中序上相邻时（例如区间互不包含，
+ *	IP 段、不重叠的时间窗）为 O(log n + k)；一般情况下最坏为 O(log n + k log(n/k))，k 为结果个数
+ *
+ *Compare 为端点的比较准则，__max_high 在旋转时以 Compare() 计算，因此 Compare 须为无状态的仿函数
+ */
+
+#ifndef _STL_INTERVAL_MAP_H_
+#define _STL_INTERVAL_MAP_H_
+
+#include "1stl_alloctor.h"
+#include "2stl_algobase.h"	//select1st
+#include "11stl_rbtree.h"
+#include <functional>		//std::less
+#include <tuple>			//forward_as_tuple
+#include <utility>			//pair forward piecewise_construct
+
+namespace lfp {
+
+	//闭区间 [low, high]，要求 !(high < low)
+	template<class Key>
+	struct interval {
+		Key low;
+		Key high;
+
+		interval() : low(), high() { }
+		interval(const Key& lo, const Key& hi) : low(lo), high(hi) { }
+	};
+
+namespace detail {
+
+/* interval_map 的元素：pair<const interval, T>，另附子树中 high 的最大值，由 __interval_augment 维护 */
+	template<class Key, class T>
+	struct __interval_value : public std::pair<const interval<Key>, T> {
+		typedef std::pair<const interval<Key>, T> base;
+
+		Key __max_high;		//以本节点为根的子树中所有区间 high 的最大值，勿直接修改
+
+		__interval_value(const interval<Key>& i, const T& x) : base(i, x), __max_high(i.high) { }
+		template<class... Args>
+		__interval_value(const interval<Key>& i, Args&&... args)
+			: base(std::piecewise_construct, std::forward_as_tuple(i), std::forward_as_tuple(std::forward<Args>(args)...)),
+			  __max_high(i.high) { }
+	};
+
+/* 区间按 (low, high) 的字典序比较 */
+	template<class Key, class Compare>
+	struct __interval_less {
+		Compare comp;
+
+		__interval_less(const Compare& c = Compare()) : comp(c) { }
+		bool operator()(const interval<Key>& x, const interval<Key>& y) const {
+			if (comp(x.low, y.low))
+				return true;
+			if (comp(y.low, x.low))
+				return false;
+			return comp(x.high, y.high);
+		}
+	};
+
+/* 维护 __max_high 的附加信息 */
+	template<class Key, class T, class Compare>
+	struct __interval_augment {
+		typedef __interval_value<Key, T> value_type;
+
+		enum { enabled = 1 };
+		static value_type& value(__rb_tree_node_base* x) {
+			return static_cast<__rb_tree_node<value_type>*>(x)->value_field;
+		}
+		static void update(__rb_tree_node_base* x) {
+			__rb_tree_default_augment::update(x);
+			value_type& v = value(x);
+			const Key* m = &v.first.high;
+			if (x->left != nullptr && Compare()(*m, value(x->left).__max_high))
+				m = &value(x->left).__max_high;
+			if (x->right != nullptr && Compare()(*m, value(x->right).__max_high))
+				m = &value(x->right).__max_high;
+			v.__max_high = *m;
+		}
+	};
+
+/* 在 rb_tree 之上增加区间查询 */
+	template<class Key, class T, class Compare, class Alloc>
+	class __interval_tree
+		: public rb_tree<interval<Key>, __interval_value<Key, T>, select1st<__interval_value<Key, T> >,
+						 __interval_less<Key, Compare>, Alloc, __interval_augment<Key, T, Compare> >
+	{
+		typedef rb_tree<interval<Key>, __interval_value<Key, T>, select1st<__interval_value<Key, T> >,
+						__interval_less<Key, Compare>, Alloc, __interval_augment<Key, T, Compare> > base;
+		typedef typename base::base_ptr base_ptr;
+	public:
+		typedef typename base::value_type value_type;
+
+		__interval_tree(const Compare& comp = Compare()) : base(__interval_less<Key, Compare>(comp)) { }
+
+		/* 对与 [lo, hi] 相交的元素按序调用 f，Ref 为传给 f 的引用型别 */
+		template<class Ref, class Visitor>
+		void overlapping(const Key& lo, const Key& hi, Visitor& f) const {
+			__overlapping<Ref>(this->root(), lo, hi, f);
+		}
+
+	private:
+		template<class Ref, class Visitor>
+		void __overlapping(base_ptr x, const Key& lo, const Key& hi, Visitor& f) const {
+			const Compare& comp = this->key_compare.comp;
+			//子树中所有区间的 high 都小于 lo 时整棵剪掉；右子树改为循环以减少递归深度
+			while (x != nullptr && !comp(base::value(x).__max_high, lo)) {
+				__overlapping<Ref>(x->left, lo, hi, f);
+				value_type& v = base::value(x);
+				if (comp(hi, v.first.low))		//x 及其右子树的 low 都大于 hi
+					return;
+				if (!comp(v.first.high, lo))
+					f(static_cast<Ref>(v));
+				x = x->right;
+			}
+		}
+	};
+
+} // end of namespace detail
+
+
+	//以下Key为区间端点型别，T为实值型别，省缺使用递增排序(less)
+	template<class Key, class T, class Compare = std::less<Key>, class Alloc = alloc>
+	class interval_map {
+	public:
+		typedef interval<Key>						key_type;		//键值型别
+		typedef Key									point_type;		//区间端点型别
+		typedef T									data_type;		//实值型别
+		typedef T									mapped_type;
+		typedef detail::__interval_value<Key, T>	value_type;		//元素型别，可当作 pair<const interval<Key>, T> 使用
+		typedef Compare								point_compare;	//端点比较仿函数
+
+	private:
+		typedef detail::__interval_tree<Key, T, Compare, Alloc> rep_type;
+
+		rep_type t;
+	public:
+		/* 与 multimap 相同，可通过 iterator 改变元素实值，区间本身不可修改 */
+		typedef typename rep_type::iterator				iterator;
+		typedef typename rep_type::const_iterator		const_iterator;
+		typedef typename rep_type::pointer				pointer;
+		typedef typename rep_type::const_pointer		const_pointer;
+		typedef typename rep_type::reference			reference;
+		typedef typename rep_type::const_reference		const_reference;
+		typedef typename rep_type::size_type			size_type;
+		typedef typename rep_type::difference_type		difference_type;
+
+		interval_map() : t(Compare()) { }
+		explicit interval_map(const Compare& comp) : t(comp) { }
+		interval_map(const interval_map<Key, T, Compare, Alloc>& x) : t(x.t) { }
+
+		interval_map<Key, T, Compare, Alloc>& operator=(const interval_map<Key, T, Compare, Alloc>& x) {
+			t = x.t;
+			return *this;
+		}
+
+		//以下所有的行为都转调用 rb_tree 的行为
+		point_compare point_comp() const { return t.key_comp().comp; }
+
+		iterator begin() { return t.begin(); }
+		const_iterator begin() const { return t.begin(); }
+		iterator end() { return t.end(); }
+		const_iterator end() const { return t.end(); }
+		bool empty() const { return t.empty(); }
+		size_type size() const { return t.size(); }
+		size_type max_size() const { return t.max_size(); }
+
+		void swap(interval_map<Key, T, Compare, Alloc>& x) { t.swap(x.t); }
+
+		//insert/erase
+		iterator insert(const key_type& i, const T& x) {
+			return t.insert_equal(value_type(i, x));
+		}
+		iterator insert(const Key& lo, const Key& hi, const T& x) {
+			return insert(key_type(lo, hi), x);
+		}
+		//以 args 就地构造实值
+		template<class... Args>
+		iterator emplace(const key_type& i, Args&&... args) {
+			return t.emplace_equal(i, std::forward<Args>(args)...);
+		}
+
+		void erase(iterator pos) { t.erase(pos); }
+		//删除所有与 i 完全相同的区间，传回删除的个数
+		size_type erase(const key_type& i) { return t.erase(i); }
+		size_type erase(const Key& lo, const Key& hi) { return t.erase(key_type(lo, hi)); }
+		void erase(iterator first, iterator last) { t.erase(first, last); }
+		void clear() { t.clear(); }
+
+		//按区间精确查找
+		iterator find(const key_type& i) { return t.find(i); }
+		const_iterator find(const key_type& i) const { return t.find(i); }
+		size_type count(const key_type& i) const { return t.count(i); }
+
+		/* 区间查询：f 依次接收每个结果元素的引用（按区间顺序），传回 f。时间复杂度见文件开头的说明 */
+		//与 [lo, hi] 相交的区间
+		template<class Visitor>
+		Visitor overlapping(const Key& lo, const Key& hi, Visitor f) {
+			t.template overlapping<reference>(lo, hi, f);
+			return f;
+		}
+		template<class Visitor>
+		Visitor overlapping(const Key& lo, const Key& hi, Visitor f) const {
+			t.template overlapping<const_reference>(lo, hi, f);
+			return f;
+		}
+		//包含点 p 的区间
+		template<class Visitor>
+		Visitor stabbing(const Key& p, Visitor f) {
+			return overlapping(p, p, f);
+		}
+		template<class Visitor>
+		Visitor stabbing(const Key& p, Visitor f) const {
+			return overlapping(p, p, f);
+		}
+	};
+
+} // end of namespace lfp
+
+#endif	//! _STL_INTERVAL_MAP_H_
@@ -14,7 +14,7 @@
 
 namespace lfp {
 
-
+
 	//省缺使用第二级空间配置器
 	template<class T, class Alloc = alloc>
 	class vector {
@@ -64,27 +64,27 @@ namespace lfp {
 		vector(size_type n, const T& value) { fill_initialize(n, value); }
 		template<class Iterator>
 		vector(Iterator first, Iterator last) {		//4 用区间初始化
-			size_type n = distance(first, last);
+			size_type n = lfp::distance(first, last);
 			start = data_allocator::allocate(n);
-			uninitialized_copy(first, last, start);
+			lfp::uninitialized_copy(first, last, start);
 			finish = start + n;
 			end_of_storage = finish;
 		}
 		vector(const vector<T>& rhs) {		//5 拷贝构造
 			start = data_allocator::allocate(rhs.size());
-			uninitialized_copy(rhs.start, rhs.finish, start);
+			lfp::uninitialized_copy(rhs.start, rhs.finish, start);
 			finish = start + rhs.size();
 			end_of_storage = finish;
 		}
 		vector(std::initializer_list<T> init_list) {		//6 列表初始化
 			start = data_allocator::allocate(init_list.size());
-			uninitialized_copy(init_list.begin(), init_list.end(), start);
+			lfp::uninitialized_copy(init_list.begin(), init_list.end(), start);
 			finish = start + init_list.size();
 			end_of_storage = finish;
 		}
 		~vector() {
 			if (start)
-				destroy(start, finish);		//将对象析构
+				lfp::destroy(start, finish);		//将对象析构
 			deallocate();			//释放内存
 		}
 
@@ -117,7 +117,7 @@ namespace lfp {
 
 		void push_back(const T& x) {
 			if (finish != end_of_storage) {		//如果空间足够则直接构造
-				construct(finish, x);
+				lfp::construct(finish, x);
 				++finish;
 			}
 			else {
@@ -131,26 +131,26 @@ namespace lfp {
 
 		void pop_back() {
 			--finish;
-			destroy(finish);
+			lfp::destroy(finish);
 		}
 
 		//删除位置 pos 上的元素
 		iterator erase(iterator pos) {		
 			if (pos + 1 != end()) {		//如果不是删除最后一个元素
-				copy(pos + 1, finish, pos);	//后续元素向前移动。交由高阶STL算法处理，实现见 2stl_algobase.h
+				lfp::copy(pos + 1, finish, pos);	//后续元素向前移动。交由高阶STL算法处理，实现见 2stl_algobase.h
 			}
 			--finish;
-			destroy(finish);
+			lfp::destroy(finish);
 			return pos;
 		}
 
 		//删除[first, last)中所有元素
 		iterator erase(iterator first, iterator last) {
 			//将[last, finish)的内容移动到从first开始位置，返回最后复制的下一位置
-			iterator it = copy(last, finish, first);
+			iterator it = lfp::copy(last, finish, first);
 
 			/* 销毁 [it, finish) 内的所有内容 */
-			destroy(it, finish);
+			lfp::destroy(it, finish);
 			finish = it;		//更新 finish 指向新的结尾
 			return first;
 		}
@@ -182,7 +182,7 @@ namespace lfp {
 			iterator new_finish = new_start;
 			try{
 				//将旧 vector 中的元素复制到新空间中
-				new_finish = uninitialized_copy(start, finish, new_start);
+				new_finish = lfp::uninitialized_copy(start, finish, new_start);
 
 			} catch (...) {
 				//捕获到异常，执行相应的销毁工作。注意：因为uninitialized_copy、uninitialized_fill_n都遵循
@@ -192,7 +192,7 @@ namespace lfp {
 			}
 
 			//析构并释放原 vector
-			destroy(begin(), end());
+			lfp::destroy(begin(), end());
 			deallocate();
 
 			//以下调整水位标记
@@ -215,7 +215,7 @@ namespace lfp {
 		//配置 n 个空间，并将其用 value 填满
 		iterator allocate_and_fill(size_type n, const T& value) {
 			iterator result = data_allocator::allocate(n);
-			uninitialized_fill_n(result, n, value);
+			lfp::uninitialized_fill_n(result, n, value);
 			return result;
 		}
 	};	//end of class vector
@@ -287,19 +287,19 @@ namespace lfp {
 				iterator old_finish = finish;
 				if (elems_after > n) {
 					//插入点之后的元素个数大于新增元素个数
-					uninitialized_copy(finish - n, finish, finish);		//在备用空间开始出再构造 n 个元素
+					lfp::uninitialized_copy(finish - n, finish, finish);		//在备用空间开始出再构造 n 个元素
 					finish += n;		//将vector尾端标记后移
-					copy_backward(pos, old_finish - n, old_finish);	//交由高阶STL算法处理，实现见 algobase.h
+					lfp::copy_backward(pos, old_finish - n, old_finish);	//交由高阶STL算法处理，实现见 algobase.h
 					//从插入点开始填入新值
-					fill(pos, pos + n, x_copy);
+					lfp::fill(pos, pos + n, x_copy);
 				}
 				else {
 					//插入点之后的元素个数小于等于新增元素个数
-					uninitialized_fill_n(finish, n - elems_after, x_copy);
+					lfp::uninitialized_fill_n(finish, n - elems_after, x_copy);
 					finish = finish + n - elems_after;
-					uninitialized_copy(pos, old_finish, finish);
+					lfp::uninitialized_copy(pos, old_finish, finish);
 					finish += elems_after;
-					fill(pos, old_finish, x_copy);
+					lfp::fill(pos, old_finish, x_copy);
 				}
 			}
 			else {		//备用空间小于新增元素个数，必须配置额外的内存
@@ -312,11 +312,11 @@ namespace lfp {
 				iterator new_finish = new_start;
 				try{
 					//以下首先将旧 vector 中插入点之前的元素复制到新空间中
-					new_finish = uninitialized_copy(start, pos, new_start);
+					new_finish = lfp::uninitialized_copy(start, pos, new_start);
 					//再将新增元素 n 填入新空间
-					new_finish = uninitialized_fill_n(new_finish, n, x);
+					new_finish = lfp::uninitialized_fill_n(new_finish, n, x);
 					//最后将旧 vector 中插入点之后的元素移动到新空间
-					new_finish = uninitialized_copy(pos, finish, new_finish);
+					new_finish = lfp::uninitialized_copy(pos, finish, new_finish);
 				} catch (...) {
 					//捕获到异常，执行相应的销毁工作。注意：因为uninitialized_copy、uninitialized_fill_n都遵循
 					//commit or rollback原则，所以构造失败时不需要自己执行对象销毁工作，只需要释放申请的内存就好
@@ -325,7 +325,7 @@ namespace lfp {
 				}
 
 				//析构并释放原 vector
-				destroy(begin(), end());
+				lfp::destroy(begin(), end());
 				deallocate();
 
 				//以下调整水位标记
@@ -338,4 +338,4 @@ namespace lfp {
 
 }// end of namespace lfp
 
-#endif // !_STL_VECTOR_H_
\ No newline at end of file
+#endif // !_STL_VECTOR_H_
\ No newline at end of file
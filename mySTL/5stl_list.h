@@ -12,6 +12,7 @@
 #include "1stl_iterator.h"		//for function distance
 #include "2stl_algobase.h"		//for diatance
 #include <cstddef>				//for ptrdiff_t
+#include <type_traits>			//for is_integral conditional
 
 namespace lfp {
 namespace detail {
@@ -124,6 +125,18 @@ namespace detail {
 			destroy(&p->data);	//销毁 data 处的内容
 			put_node(p);		//释放内存
 		}
+		//产生一个含有 n 个 x 的链表
+		void fill_initialize(size_type n, const T& x) {
+			empty_initialize();
+			try {
+				fill_append(n, x);
+			}
+			catch (...) {
+				clear();
+				put_node(node);
+				throw;
+			}
+		}
 		//产生一个空链表
 		void empty_initialize() {
 			node = get_node();		//配置一个节点，令 node 指向它
@@ -132,20 +145,102 @@ namespace detail {
 			size_ = 0;
 		}
 
+		//在链表尾部依次追加 n 个 x 或 [first, last) 内的元素。节点先串成一条链，只维护局部的尾指针，
+		//最后再一次性接到头节点上并修正 size_。抛出异常时已构造的节点仍然正确地链接在链表中，由调用者回滚
+		void fill_append(size_type n, const T& x) {
+			node_pointer tail = node->prev;
+			size_type count = 0;
+			try {
+				for (; count < n; ++count) {
+					node_pointer p = create_node(x);
+					tail->next = p;
+					p->prev = tail;
+					tail = p;
+				}
+			}
+			catch (...) {
+				close_chain(tail, count);
+				throw;
+			}
+			close_chain(tail, count);
+		}
+		template<class InputIterator>
+		void range_append(InputIterator first, InputIterator last) {
+			node_pointer tail = node->prev;
+			size_type count = 0;
+			try {
+				for (; first != last; ++first, ++count) {
+					node_pointer p = create_node(*first);
+					tail->next = p;
+					p->prev = tail;
+					tail = p;
+				}
+			}
+			catch (...) {
+				close_chain(tail, count);
+				throw;
+			}
+			close_chain(tail, count);
+		}
+		//两个参数为整数型别时（如 list<double>(3, 0)）表示 n 个 value，不能当作迭代器
+		template<class Integer>
+		void range_append(Integer n, Integer value, detail::__true_type) { fill_append(size_type(n), T(value)); }
+		template<class InputIterator>
+		void range_append(InputIterator first, InputIterator last, detail::__false_type) { range_append(first, last); }
+		template<class InputIterator>
+		struct is_integer {
+			typedef typename std::conditional<std::is_integral<InputIterator>::value, detail::__true_type, detail::__false_type>::type type;
+		};
+		//将追加的链的尾部接回头节点
+		void close_chain(node_pointer tail, size_type count) {
+			tail->next = node;
+			node->prev = tail;
+			size_ += count;
+		}
+
 		/* list 内部函数，为 splice sort merge 等奠定基础 */
 		//将 [first, last) 内的所有元素接合于 pos 所指位置之前，pos 和
 		//[first, last)可以指向同一个list，但 pos 不能位于 [first, last) 之内
-		void transfer(iterator first, iterator last, iterator pos);
-
-		//sort 内调函数声明
-		iterator QuickSortCore(iterator low, iterator high);
-		void QuickSort(iterator low, iterator high);
+		void transfer(iterator pos, iterator first, iterator last);
 
 	public:
 		list() { empty_initialize(); }
+		explicit list(size_type n) { fill_initialize(n, T()); }
+		list(size_type n, const T& value) { fill_initialize(n, value); }
+		list(int n, const T& value) { fill_initialize(n, value); }
+		template<class InputIterator>
+		list(InputIterator first, InputIterator last) {
+			empty_initialize();
+			try {
+				range_append(first, last, typename is_integer<InputIterator>::type());
+			}
+			catch (...) {
+				clear();
+				put_node(node);
+				throw;
+			}
+		}
+		list(const list<T, Alloc>& x) {
+			empty_initialize();
+			try {
+				range_append(x.begin(), x.end());
+			}
+			catch (...) {
+				clear();
+				put_node(node);
+				throw;
+			}
+		}
 		~list() {
 			clear();
-			destroy_node(node);
+			put_node(node);		//头节点没有构造元素，只释放空间
+		}
+		list<T, Alloc>& operator=(const list<T, Alloc>& x) {
+			if (&x != this) {
+				list<T, Alloc> tmp(x);
+				swap(tmp);
+			}
+			return *this;
 		}
 
 		//这里会构造一个iterator对象
@@ -163,6 +258,20 @@ namespace detail {
 
 		//在迭代器pos所指位置插入一个节点，返回插入后该位置的迭代器
 		iterator insert(iterator pos, const T& x);
+		//在迭代器pos所指位置之前插入 n 个 x 或 [first, last) 内的元素
+		//先在临时链表中构造好整条链，再用一次 transfer 接合进来；构造失败时临时链表析构，*this 不变
+		void insert(iterator pos, size_type n, const T& x) {
+			list<T, Alloc> tmp;
+			tmp.fill_append(n, x);
+			splice(pos, tmp);
+		}
+		void insert(iterator pos, int n, const T& x) { insert(pos, size_type(n), x); }
+		template<class InputIterator>
+		void insert(iterator pos, InputIterator first, InputIterator last) {
+			list<T, Alloc> tmp;
+			tmp.range_append(first, last, typename is_integer<InputIterator>::type());
+			splice(pos, tmp);
+		}
 
 		//移除迭代器pos所指结点，返回移除后该位置的迭代器
 		iterator erase(iterator pos);
@@ -187,14 +296,29 @@ namespace detail {
 		//[first, last)可以指向同一个list，但 pos 不能位于 [first, last) 之内
 		void splice(iterator pos, iterator first, iterator last);
 
-		//merge 将x合并到this身上，前提是两个list已经递增排序好了
-		void merge(list<T, Alloc>& x);
+		//merge 将x合并到this身上，前提是两个list已经递增排序好了，合并后 x 为空
+		void merge(list<T, Alloc>& x) { merge(x, less<T>()); }
+		//同上，但两个list已经按 comp 排序好了
+		template<class Compare>
+		void merge(list<T, Alloc>& x, Compare comp);
 		//reserve 将this的内容逆向重置
 		void reverse();
+		//交换两个 list 的内容，只交换头节点指针和元素个数
+		void swap(list<T, Alloc>& x) {
+			node_pointer tmp = node;
+			node = x.node;
+			x.node = tmp;
+			size_type n = size_;
+			size_ = x.size_;
+			x.size_ = n;
+		}
 
-		//以下我使用快速排序按非递减方式排序
+		//以下使用自底向上的归并排序按非递减方式排序，只调整节点指针，不复制元素
+		//排序是稳定的，时间复杂度总是 O(nlogn)，除64个空链表外不需要额外的空间
 		//list不能使用STL的排序算法，因为STL的sort只接受随机迭代器
-		void sort();
+		void sort() { sort(less<T>()); }
+		template<class Compare>
+		void sort(Compare comp);
 	};
 
 
@@ -279,6 +403,7 @@ namespace detail {
 		if (!x.empty()) {
 			transfer(pos, x.begin(), x.end());
 			size_ += x.size();
+			x.size_ = 0;
 		}
 	}
 
@@ -303,18 +428,23 @@ namespace detail {
 		}
 	}
 
-	//merge 将x合并到this身上，前提是两个list已经递增排序好了
+	//merge 将x合并到this身上，前提是两个list已经按 comp 排序好了
 	template<class T, class Alloc>
-	void list<T, Alloc>::merge(list<T, Alloc>& x) {
+	template<class Compare>
+	void list<T, Alloc>::merge(list<T, Alloc>& x, Compare comp) {
+		if (&x == this)
+			return;
+
 		iterator first1 = begin();
 		iterator last1 = end();
 		iterator first2 = x.begin();
 		iterator last2 = x.end();
 		size_ += x.size();
+		x.size_ = 0;
 
-		//注意：前提是两个 list 已经经过递增排序
+		//注意：前提是两个 list 已经经过排序。相等时保留 this 中的元素在前，保证稳定
 		while (first1 != last1 && first2 != last2) {
-			if (*first2 < *first1) {
+			if (comp(*first2, *first1)) {
 				iterator next = first2;
 				transfer(first1, first2, ++next);
 				first2 = next;
@@ -344,13 +474,46 @@ namespace detail {
 		}
 	}
 
-	//对外接口
+	//自底向上的归并排序：counter[i] 为空或保存一段长度为 2^i 的有序链表。每次从 this 中
+	//摘下一个节点，像二进制加法进位一样依次与 counter[0]、counter[1]... 合并，最后把
+	//所有 counter 合并起来。每个节点只被 merge 移动 O(logn) 次，且总是在较短的链表上进行
 	template<class T, class Alloc>
-	void list<T, Alloc>::sort() {
+	template<class Compare>
+	void list<T, Alloc>::sort(Compare comp) {
 		//首先判断链表为空或只有一个元素则不进行任何操作
 		if (node->next == node || (node->next)->next == node)
 			return;
-		QuickSort(begin(), --end());
+
+		list<T, Alloc> carry;
+		list<T, Alloc> counter[64];		//64 个足以容纳 2^64 - 1 个节点
+		int fill = 0;
+		try {
+			while (!empty()) {
+				iterator next = begin();
+				carry.transfer(carry.begin(), begin(), ++next);		//摘下第一个节点
+				carry.size_ = 1;
+				--size_;
+
+				int i = 0;
+				while (i < fill && !counter[i].empty()) {		//进位
+					counter[i].merge(carry, comp);		//counter[i] 中的元素较早，相等时在前，保证稳定
+					carry.swap(counter[i++]);
+				}
+				carry.swap(counter[i]);
+				if (i == fill)
+					++fill;
+			}
+
+			for (int i = 1; i < fill; ++i)
+				counter[i].merge(counter[i - 1], comp);
+			swap(counter[fill - 1]);
+		}
+		catch (...) {		//comp 抛出异常时把所有节点接回 this，不丢失任何元素
+			splice(end(), carry);
+			for (int i = 0; i < fill; ++i)
+				splice(end(), counter[i]);
+			throw;
+		}
 	}
 
 
@@ -381,43 +544,6 @@ namespace detail {
 		}
 	}
 
-
-	//以下使用快速排序
-	//list 不能使用STL的排序算法，因为STL的sort只接受随机迭代器
-	template<class T, class Alloc>
-	typename list<T, Alloc>::iterator
-		list<T, Alloc>::QuickSortCore(iterator low, iterator high) {
-		value_type pivotkey = (low.node)->data;
-		while (low != high) {
-			while (low != high && (high.node)->data >= pivotkey)
-				--high;
-			(low.node)->data = (high.node)->data;
-			while (low != high && (low.node)->data <= pivotkey)
-				++low;
-			(high.node)->data = (low.node)->data;
-		}
-		(low.node)->data = pivotkey;
-		return low;		//返回枢轴所在位置
-	}
-
-	template<class T, class Alloc>
-	void list<T, Alloc>::QuickSort(iterator low, iterator high) {
-		if (low != high) {
-			iterator pivot = QuickSortCore(low, high);
-			if (pivot == low) {
-				QuickSort(++pivot, high);
-			}
-			else if (pivot == high) {
-				QuickSort(low, --high);
-			}
-			else {
-				iterator pivot2 = pivot;
-				QuickSort(low, --pivot2);		//对前半部分进行排序
-				QuickSort(++pivot, high);		//对后半部分进行排序
-			}
-		}
-	}
-
 }// end of namespace lfp
 
 #endif // !_STL_VECTOR_H_
@@ -12,26 +12,66 @@
 #include "1stl_uninitialized.h"
 #include "2stl_algobase.h"
 
+#ifndef __STL_DEQUE_BLOCK_BYTES
+	#define __STL_DEQUE_BLOCK_BYTES 512		//缓冲区的缺省字节数，可在包含本文件之前重新定义
+#endif
+
 namespace lfp {
+
+/* 每种元素型别的缓冲区字节数，缺省为 __STL_DEQUE_BLOCK_BYTES
+ * 元素较大时可以为其特化，例如：
+ *	template<> struct deque_block_bytes<Record> { static const size_t value = 4096; };
+ */
+	template<class T>
+	struct deque_block_bytes {
+		static const size_t value = __STL_DEQUE_BLOCK_BYTES;
+	};
+
 namespace detail {
 
-/* 全局函数: 用于辅助决定缓冲区大小
- * 如果buf_size不为0，传回由用户定义的buf_size，表示一个缓冲区可以容纳 buf_size 个元素
- * 如果 buf_size 为0，表示 buffer size 使用默认值，那么：
- * 	 如果 val_size(sizeof(value_type))小于512，返回 512 / val_size，一个缓冲区可容纳 512 / val_size 个元素
- * 	 如果 val_size >= 512，返回 1，一个缓冲区可容纳 1 个元素
+	//编译期计算 floor(log2(N))
+	template<size_t N>
+	struct __deque_log2 {
+		static const size_t value = 1 + __deque_log2<N / 2>::value;
+	};
+	template<>
+	struct __deque_log2<1> {
+		static const size_t value = 0;
+	};
+	template<>
+	struct __deque_log2<0> {
+		static const size_t value = 0;
+	};
+
+/* 缓冲区的几何形状：一个缓冲区容纳的元素个数总是 2 的幂，
+ * 于是迭代器的随机访问只需移位和掩码，不必做整数除法与取模
+ * 如果 BufSize 不为0，表示用户指定一个缓冲区至少容纳 BufSize 个元素，向上取整为 2 的幂
+ * 如果 BufSize 为0，使用缺省值，那么：
+ *	 如果 sizeof(T) 小于 deque_block_bytes<T>::value，取不超过 bytes / sizeof(T) 的最大的 2 的幂
+ *	 否则一个缓冲区容纳 1 个元素
  */
-inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
-	return (buf_size != 0) ? buf_size
-			: ( (val_size < 512) ? size_t(512 / val_size) : size_t(1) );
-}
+	template<class T, size_t BufSize>
+	struct __deque_block_geometry {
+	private:
+		static const size_t bytes = deque_block_bytes<T>::value;
+		static const size_t raw = (BufSize != 0) ? BufSize
+								: ((sizeof(T) < bytes) ? bytes / sizeof(T) : 1);
+		static const size_t floor_shift = __deque_log2<raw>::value;
+
+	public:
+		static const size_t shift = (BufSize != 0 && (size_t(1) << floor_shift) != raw)
+									? floor_shift + 1 : floor_shift;
+		static const size_t size = size_t(1) << shift;		//一个缓冲区容纳的元素个数
+		static const size_t mask = size - 1;
+	};
 
 
 /* deque 迭代器的设计 */
 	template<class T, class Ref, class Ptr, size_t BufSize>
 	struct __deque_iterator {
 	public:
-		static size_t buffer_size() { return __deque_buf_size(BufSize, sizeof(T)); }
+		typedef __deque_block_geometry<T, BufSize>					geometry;
+		static size_t buffer_size() { return geometry::size; }
 		typedef __deque_iterator<T, T&, T*, BufSize>				iterator;
 		typedef __deque_iterator<T, const T&, const T*, BufSize>	const_iterator;
 
@@ -54,6 +94,10 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		T* last;			//指向缓冲区行的尾，永远指向最后一个元素的下一位置
 		map_pointer node;	//指向中控器中当前迭代器所指节点
 
+		__deque_iterator() : cur(0), first(0), last(0), node(0) { }
+		//由 iterator 转换为 const_iterator
+		__deque_iterator(const iterator& x) : cur(x.cur), first(x.first), last(x.last), node(x.node) { }
+
 		// 以下是迭代器运算的一些关键行为 
 		/* 使 node 跳跃到新的缓冲区 new_node */
 		void set_node(map_pointer new_node) {
@@ -110,16 +154,16 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		/* 重载 += 运算符。注意：+= 运算符改变 this 指针 */
 		self& operator+=(difference_type n) {
 			difference_type offset = n + (cur - first);		//算出移动后的 cur 相对于当前 first 的位置
-			if (offset >= 0 && offset < difference_type(buffer_size())) {
+			if (size_t(offset) < geometry::size) {		//无符号比较同时排除了 offset < 0
 				cur += n;	 //目标位置在当前缓冲区内
 			}
-			else {		//目标位置不在当前缓冲区内
-				difference_type node_offset = (offset > 0) ? offset / difference_type(buffer_size())
-					: -difference_type((-offset - 1) / buffer_size()) - 1;
+			else {		//目标位置不在当前缓冲区内，缓冲区大小是 2 的幂，以移位代替除法（向下取整）
+				difference_type node_offset = (offset > 0) ? (offset >> geometry::shift)
+					: -((-offset - 1) >> geometry::shift) - 1;
 				//切换到正确的缓冲区节点
 				set_node(node + node_offset);
-				//切换至正确的元素
-				cur = first + (offset - node_offset * difference_type(buffer_size()));
+				//切换至正确的元素，以掩码代替取模
+				cur = first + difference_type(size_t(offset) & geometry::mask);
 			}
 			return *this;
 		}
@@ -151,6 +195,192 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 
 
 
+/* 以下是针对 deque 迭代器的分段算法
+ * deque 的元素分段存放在各个缓冲区之中，逐个元素 ++ 每一步都要检查是否到达缓冲区尾端。
+ * 以下重载逐个缓冲区处理连续的 [first, last) 区段，每一段交给原生指针版本，
+ * 从而使 copy 等算法对 trivial 型别的 memmove 路径能够按段生效
+ */
+
+	//原生指针区间拷贝到 deque：按目的缓冲区分段
+	template<class T, size_t BufSize>
+	detail::__deque_iterator<T, T&, T*, BufSize>
+	copy(const T* first, const T* last, detail::__deque_iterator<T, T&, T*, BufSize> result) {
+		ptrdiff_t n = last - first;
+		while (n > 0) {
+			ptrdiff_t len = min(n, ptrdiff_t(result.last - result.cur));	//目的缓冲区剩余的空间
+			lfp::copy(first, first + len, result.cur);
+			first += len;
+			n -= len;
+			result += len;
+		}
+		return result;
+	}
+	template<class T, size_t BufSize>
+	inline detail::__deque_iterator<T, T&, T*, BufSize>
+	copy(T* first, T* last, detail::__deque_iterator<T, T&, T*, BufSize> result) {
+		return lfp::copy((const T*)first, (const T*)last, result);
+	}
+
+	//deque 区间拷贝到任意目的地（包括原生指针与另一个 deque）：按来源缓冲区分段
+	template<class T, class Ref, class Ptr, size_t BufSize, class OutputIterator>
+	OutputIterator copy(detail::__deque_iterator<T, Ref, Ptr, BufSize> first,
+						detail::__deque_iterator<T, Ref, Ptr, BufSize> last, OutputIterator result) {
+		if (first.node == last.node)
+			return lfp::copy(first.cur, last.cur, result);
+		result = lfp::copy(first.cur, first.last, result);
+		for (T** node = first.node + 1; node != last.node; ++node)
+			result = lfp::copy(*node, *node + first.buffer_size(), result);
+		return lfp::copy(last.first, last.cur, result);
+	}
+
+	//原生指针区间从后往前拷贝到 deque：按目的缓冲区分段
+	template<class T, size_t BufSize>
+	detail::__deque_iterator<T, T&, T*, BufSize>
+	copy_backward(const T* first, const T* last, detail::__deque_iterator<T, T&, T*, BufSize> result) {
+		ptrdiff_t n = last - first;
+		while (n > 0) {
+			ptrdiff_t room = result.cur - result.first;		//目的缓冲区中 result 之前的空间
+			T* rlast = result.cur;
+			if (room == 0) {		//result 位于缓冲区头部，写入前一个缓冲区的尾部
+				room = ptrdiff_t(result.buffer_size());
+				rlast = *(result.node - 1) + room;
+			}
+			ptrdiff_t len = min(n, room);
+			lfp::copy_backward(last - len, last, rlast);
+			last -= len;
+			n -= len;
+			result -= len;
+		}
+		return result;
+	}
+	template<class T, size_t BufSize>
+	inline detail::__deque_iterator<T, T&, T*, BufSize>
+	copy_backward(T* first, T* last, detail::__deque_iterator<T, T&, T*, BufSize> result) {
+		return lfp::copy_backward((const T*)first, (const T*)last, result);
+	}
+
+	//deque 区间从后往前拷贝到任意目的地：按来源缓冲区分段
+	template<class T, class Ref, class Ptr, size_t BufSize, class BidirectionalIterator>
+	BidirectionalIterator copy_backward(detail::__deque_iterator<T, Ref, Ptr, BufSize> first,
+										detail::__deque_iterator<T, Ref, Ptr, BufSize> last, BidirectionalIterator result) {
+		if (first.node == last.node)
+			return lfp::copy_backward(first.cur, last.cur, result);
+		result = lfp::copy_backward(last.first, last.cur, result);
+		for (T** node = last.node - 1; node != first.node; --node)
+			result = lfp::copy_backward(*node, *node + first.buffer_size(), result);
+		return lfp::copy_backward(first.cur, first.last, result);
+	}
+
+	template<class T, size_t BufSize, class V>
+	void fill(detail::__deque_iterator<T, T&, T*, BufSize> first,
+			  detail::__deque_iterator<T, T&, T*, BufSize> last, const V& value) {
+		if (first.node == last.node) {
+			lfp::fill(first.cur, last.cur, value);
+			return;
+		}
+		lfp::fill(first.cur, first.last, value);
+		for (T** node = first.node + 1; node != last.node; ++node)
+			lfp::fill(*node, *node + first.buffer_size(), value);
+		lfp::fill(last.first, last.cur, value);
+	}
+
+	template<class T, class Ref, class Ptr, size_t BufSize, class V>
+	detail::__deque_iterator<T, Ref, Ptr, BufSize>
+	find(detail::__deque_iterator<T, Ref, Ptr, BufSize> first,
+		 detail::__deque_iterator<T, Ref, Ptr, BufSize> last, const V& value) {
+		if (first.node == last.node) {
+			first.cur = lfp::find(first.cur, last.cur, value);
+			return first;
+		}
+		T* p = lfp::find(first.cur, first.last, value);
+		if (p != first.last) {
+			first.cur = p;
+			return first;
+		}
+		for (T** node = first.node + 1; node != last.node; ++node) {
+			T* block_last = *node + first.buffer_size();
+			p = lfp::find(*node, block_last, value);
+			if (p != block_last) {
+				first.set_node(node);
+				first.cur = p;
+				return first;
+			}
+		}
+		last.cur = lfp::find(last.first, last.cur, value);
+		return last;
+	}
+
+	//元素以 Ptr 型别交给 f，const_iterator 不会暴露可修改的引用
+	template<class T, class Ref, class Ptr, size_t BufSize, class Function>
+	Function for_each(detail::__deque_iterator<T, Ref, Ptr, BufSize> first,
+					  detail::__deque_iterator<T, Ref, Ptr, BufSize> last, Function f) {
+		if (first.node == last.node)
+			return lfp::for_each(Ptr(first.cur), Ptr(last.cur), f);
+		f = lfp::for_each(Ptr(first.cur), Ptr(first.last), f);
+		for (T** node = first.node + 1; node != last.node; ++node)
+			f = lfp::for_each(Ptr(*node), Ptr(*node + first.buffer_size()), f);
+		return lfp::for_each(Ptr(last.first), Ptr(last.cur), f);
+	}
+
+	/* lower_bound: 先以各缓冲区的首元素在 map 上二分，确定目标缓冲区，再在该缓冲区内二分
+	 * 比较次数仍为 O(log n)，但只有最后一步需要在缓冲区内移动迭代器
+	 */
+	template<class T, class Ref, class Ptr, size_t BufSize, class V, class Compare>
+	detail::__deque_iterator<T, Ref, Ptr, BufSize>
+	lower_bound(detail::__deque_iterator<T, Ref, Ptr, BufSize> first,
+				detail::__deque_iterator<T, Ref, Ptr, BufSize> last, const V& value, Compare comp) {
+		if (first.node == last.node) {
+			first.cur = lfp::lower_bound(first.cur, last.cur, value, comp);
+			return first;
+		}
+		//在 (first.node, last.node] 中找出第一个首元素不小于 value 的缓冲区。
+		//中间的缓冲区都是饱满的；last.node 即使为空，也把它当作不小于 value
+		T** lo = first.node + 1;
+		T** hi = last.node;
+		while (lo < hi) {
+			T** mid = lo + (hi - lo) / 2;
+			if (comp(**mid, value))
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		if (lo == last.node && last.cur != last.first && comp(*last.first, value)) {
+			//目标位于最后一个缓冲区之内
+			last.cur = lfp::lower_bound(last.first, last.cur, value, comp);
+			return last;
+		}
+		//目标位于 lo 的前一个缓冲区之内，或者恰为 lo 缓冲区的首元素
+		T* block_first = (lo - 1 == first.node) ? first.cur : *(lo - 1);
+		T* block_last = *(lo - 1) + first.buffer_size();
+		T* p = lfp::lower_bound(block_first, block_last, value, comp);
+		if (p != block_last) {
+			first.set_node(lo - 1);
+			first.cur = p;
+		}
+		else {
+			first.set_node(lo);
+			first.cur = first.first;
+		}
+		return first;
+	}
+
+namespace detail {
+	//以 < 比较，供 lower_bound 版本1 使用
+	struct __deque_less_than {
+		template<class T1, class T2>
+		bool operator()(const T1& a, const T2& b) const { return a < b; }
+	};
+}// end of namespace detail
+
+	template<class T, class Ref, class Ptr, size_t BufSize, class V>
+	inline detail::__deque_iterator<T, Ref, Ptr, BufSize>
+	lower_bound(detail::__deque_iterator<T, Ref, Ptr, BufSize> first,
+				detail::__deque_iterator<T, Ref, Ptr, BufSize> last, const V& value) {
+		return lfp::lower_bound(first, last, value, detail::__deque_less_than());
+	}
+
+
+
 /* deque 结构的设计 */
 	template<class T, class Alloc = alloc, size_t BufSize = 0>
 	struct deque {
@@ -166,7 +396,7 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		typedef typename detail::__deque_iterator<T, T&, T*, BufSize>::size_type			size_type;
 		typedef typename detail::__deque_iterator<T, T&, T*, BufSize>::difference_type		difference_type;
 		
-		size_t (*buffer_size)() = detail::__deque_iterator<T, T&, T*, BufSize>::buffer_size;
+		static size_t buffer_size() { return iterator::buffer_size(); }
 
 	protected:
 		typedef T** map_pointer;
@@ -176,6 +406,13 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		map_pointer map;		//指向中控器map，map是连续空间，其每个元素都指向某行缓冲区（缓冲区连续）
 		size_type map_size;		//map 总共课容纳缓冲区的个数
 
+		//空闲缓冲区缓存：pop_front/pop_back/erase/clear 腾空的缓冲区先放在这里，
+		//push_back_aux/push_front_aux 需要新缓冲区时优先从这里取，头尾两端共用。
+		//队列式（尾进头出）的使用方式下，稳定状态不再调用配置器
+		enum { max_spare_buffers = 4 };		//最多缓存的缓冲区个数
+		pointer spare[max_spare_buffers];
+		size_type spare_count;
+
 		//deque 专属空间配置器
 	protected:
 		typedef simple_alloc<value_type, Alloc> data_allocator;
@@ -185,6 +422,25 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 
 		//用于维护 deque 结构的内部方法
 
+		/* 取得一个缓冲区：优先使用缓存中的空闲缓冲区 */
+		pointer allocate_buffer() {
+			if (spare_count != 0)
+				return spare[--spare_count];
+			return data_allocator::allocate(buffer_size());
+		}
+		/* 归还一个缓冲区：缓存未满时留待复用，否则交还配置器 */
+		void deallocate_buffer(pointer p) {
+			if (spare_count < max_spare_buffers)
+				spare[spare_count++] = p;
+			else
+				data_allocator::deallocate(p, buffer_size());
+		}
+		/* 将缓存中的空闲缓冲区全部交还配置器 */
+		void release_spare_buffers() {
+			while (spare_count != 0)
+				data_allocator::deallocate(spare[--spare_count], buffer_size());
+		}
+
 		void fill_initialize(size_type n, const value_type& value);
 		/* 负责实现deque的结构，并将元素设定为初值 value */
 		void create_map_and_nodes(size_type num_elem);
@@ -220,19 +476,62 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 
 	/* deque 对外接口 */
 	public:		//Basic accessors
-		deque() : start(), finish(), map(0), map_size(0) {
+		deque() : start(), finish(), map(0), map_size(0), spare_count(0) {
 			create_map_and_nodes(0);		//拥有0个元素、1个缓冲区、map大小为 3
 		}
-		deque(int n, const value_type& value) : start(), finish(), map(0), map_size(0) {
+		deque(int n, const value_type& value) : start(), finish(), map(0), map_size(0), spare_count(0) {
 			fill_initialize(n, value);
 		}
+		deque(const deque& x) : start(), finish(), map(0), map_size(0), spare_count(0) {
+			create_map_and_nodes(x.size());
+			try {
+				lfp::uninitialized_copy(x.begin(), x.end(), start);
+			}
+			catch (...) {
+				for (map_pointer cur = start.node; cur <= finish.node; ++cur)
+					data_allocator::deallocate(*cur, buffer_size());
+				map_allocator::deallocate(map, map_size);
+				throw;
+			}
+		}
+		deque& operator=(const deque& x) {
+			if (this != &x) {
+				deque tmp(x);
+				swap(tmp);
+			}
+			return *this;
+		}
+		~deque() {
+			destroy(start, finish);
+			for (map_pointer cur = start.node; cur <= finish.node; ++cur)
+				data_allocator::deallocate(*cur, buffer_size());
+			release_spare_buffers();
+			map_allocator::deallocate(map, map_size);
+		}
+
+		//两个 deque 互换，只需交换 map、迭代器与缓存的空闲缓冲区
+		void swap(deque& x) {
+			lfp::swap(start, x.start);
+			lfp::swap(finish, x.finish);
+			lfp::swap(map, x.map);
+			lfp::swap(map_size, x.map_size);
+			for (size_type i = 0; i < max_spare_buffers; ++i)
+				lfp::swap(spare[i], x.spare[i]);
+			lfp::swap(spare_count, x.spare_count);
+		}
 
 		iterator begin() { return start; }
 		const_iterator begin() const { return start; }
 		iterator end() { return finish; }
 		const_iterator end() const { return finish; }
+		//n 一定不小于0，直接以移位和掩码定位缓冲区及其中的元素
 		reference operator[](size_type n) {
-			return start[difference_type(n)];		//调用 __deque_iterator<>::operator[]
+			size_type offset = n + (start.cur - start.first);
+			return start.node[offset >> iterator::geometry::shift][offset & iterator::geometry::mask];
+		}
+		const_reference operator[](size_type n) const {
+			size_type offset = n + (start.cur - start.first);
+			return start.node[offset >> iterator::geometry::shift][offset & iterator::geometry::mask];
 		}
 		reference front() { return *start; }		//调用 __deque_iterator<>::operator*
 		const_reference front() const { return *start; }		//调用 __deque_iterator<>::operator*
@@ -282,7 +581,7 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 				destroy(finish.cur);	//将最后元素析构
 			}
 			else {		//最后缓冲区没有元素，这里将进行缓冲区的释放
-				data_allocator::deallocate(finish.first, buffer_size());		//释放最后一个缓冲区
+				deallocate_buffer(finish.first);		//归还最后一个缓冲区
 				finish.set_node(finish.node - 1);		//调整 finish 的状态，使其指向上一个缓冲区的最后一个元素
 				finish.cur = finish.last - 1;
 				destroy(finish.cur);		//将该元素析构
@@ -296,7 +595,7 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 			}
 			else {			//第一缓冲区仅有一个元素，这里将进行缓冲区的释放
 				destroy(start.cur);		//将第一个缓冲区的最后一个元素析构
-				data_allocator::deallocate(start.first, buffer_size());		//释放第一缓冲区
+				deallocate_buffer(start.first);		//归还第一缓冲区
 				start.set_node(start.node + 1);		//调整缓冲区的状态，使其指向下一个缓冲区的第一个元素
 				start.cur = start.first;
 			}
@@ -310,6 +609,19 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		iterator erase(iterator first, iterator last);
 		//在 pos 出插入一个值为 x 的元素
 		iterator insert(iterator pos, const value_type& x);
+
+		//将缓存的空闲缓冲区交还配置器。map 本身不缩小
+		void shrink_to_fit() { release_spare_buffers(); }
+
+		//预先扩充 map，使元素个数增长到 n 之前的 push_back 都不必更换 map。缓冲区仍在需要时才配置
+		void reserve(size_type n) {
+			size_type sz = size();
+			if (n <= sz)
+				return;
+			size_type room = finish.last - finish.cur - 1;		//最后一个缓冲区不必配置新缓冲区即可压入的元素个数
+			if (n - sz > room)
+				reserve_map_at_back((n - sz - room + buffer_size() - 1) / buffer_size());
+		}
 	};
 
 
@@ -323,10 +635,10 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		try {
 			for (cur = start.node; cur < finish.node; ++cur) {
 				/* 先为每个饱和节点设定初值 */
-				uninitialized_fill(*cur, *cur + buffer_size(), value);
+				lfp::uninitialized_fill(*cur, *cur + buffer_size(), value);
 			}
 			/* 最后一个节点的设定稍有不同，因为它可能不饱和 */
-			uninitialized_fill(finish.first, finish.cur, value);
+			lfp::uninitialized_fill(finish.first, finish.cur, value);
 		}
 		catch (...) {
 			/* 先将已构造的元素销毁 */
@@ -345,7 +657,7 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 	template<class T, class Alloc, size_t BufSize>
 	void deque<T, Alloc, BufSize>::create_map_and_nodes(size_type num_elements) {
 		//需要节点数 = (元素个数 / 缓冲区大小可容纳元素个数) + 1，如果刚好整除会多配一个节点设为last
-		size_type num_nodes = num_elements / buffer_size() + 1;
+		size_type num_nodes = (num_elements >> iterator::geometry::shift) + 1;
 
 		//一个map最少管理3个节点，最多管理所需节点数+2，前后各留一个便于扩展
 		map_size = num_nodes + 2;
@@ -378,7 +690,7 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		finish.set_node(nfinish);
 		//为了维持前闭后开区间属性，如果未整除，则 finish.cur 指向最后一个元素的下一个位置，此时 finish 指向的块内有元素
 		//如果刚好能整除，前面说会多配一个节点，此时令 finish.cur 指向这多配的一个节点的起始处，此时 finish 指向的块内没有元素
-		finish.cur = finish.first + (num_elements % buffer_size());
+		finish.cur = finish.first + (num_elements & iterator::geometry::mask);
 	}
 
 
@@ -395,11 +707,11 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 						+ (add_at_front ? nodes_to_add : 0);
 			/* 如果新起点在原起点的前面 */
 			if (new_nstart < start.node) {
-				copy(start.node, finish.node + 1, new_nstart);
+				lfp::copy(start.node, finish.node + 1, new_nstart);
 				/* 将原缓冲区信息向前拷贝 */
 			}
 			else {
-				copy_backward(start.node, finish.node + 1, new_nstart + old_num_nodes);
+				lfp::copy_backward(start.node, finish.node + 1, new_nstart + old_num_nodes);
 				/* 将原缓冲区信息向后拷贝 */
 			}
 		}
@@ -410,7 +722,7 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 						+ (add_at_front ? nodes_to_add : 0);
 
 			//接下来把原map内容拷贝过来，释放原map，设定新map的起始地址和大小
-			copy(start.node, finish.node + 1, new_nstart);
+			lfp::copy(start.node, finish.node + 1, new_nstart);
 			map_allocator::deallocate(map, map_size);
 			map = new_map;
 			map_size = new_map_size;
@@ -427,14 +739,14 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 	void deque<T, Alloc, BufSize>::push_back_aux(const value_type& t) {
 		value_type t_copy = t;
 		reserve_map_at_back();		//当 map 的备用空间已用完时，无法再增加缓冲区节点，必须换一个更大的 map
-		*(finish.node + 1) = data_allocator::allocate(buffer_size());		//配置一个新缓冲区节点
+		*(finish.node + 1) = allocate_buffer();		//取得一个新缓冲区节点
 		try {
 			construct(finish.cur, t_copy);		//在原始 finish 所指缓冲区的最后一个存储位置构造元素
 			finish.set_node(finish.node + 1);	//更新 finish 所指节点
 			finish.cur = finish.first;			//设置 finish 的状态
 		}
 		catch (...) {		//发生异常，将新配置的节点(finish所指节点的下一个节点)释放
-			data_allocator::deallocate(*(finish.node + 1));
+			deallocate_buffer(*(finish.node + 1));
 			throw;
 		}
 	}
@@ -446,7 +758,7 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 	void deque<T, Alloc, BufSize>::push_front_aux(const value_type& t) {
 		value_type t_copy = t;
 		reserve_map_at_front();		//当 map 的备用空间已用完时，无法再增加缓冲区节点，必须换一个更大的 map
-		*(start.node - 1) = data_allocator::allocate(buffer_size());		//配置一个新缓冲区节点
+		*(start.node - 1) = allocate_buffer();		//取得一个新缓冲区节点
 		try {
 			start.set_node(start.node - 1);		//更新 start 指向新节点
 			start.cur = start.last - 1;			//设置 start 的状态
@@ -455,7 +767,7 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		catch (...) {		//发生异常，释放新节点，恢复到原始状态
 			start.set_node(start.node + 1);
 			start.cur = start.first;
-			data_allocator::deallocate(*(start.node - 1));
+			deallocate_buffer(*(start.node - 1));
 			throw;
 		}
 	}
@@ -467,15 +779,15 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		for (map_pointer node = start.node + 1; node < finish.node; ++node) {
 			destroy(*node, *node + buffer_size());
 			/* 将缓冲区内的所有元素析构，调用的是destroy的第二版本 */
-			data_allocator::deallocate(*node, buffer_size());
-			/* 释放缓冲区内存 */
+			deallocate_buffer(*node);
+			/* 归还缓冲区，缓存已满时才真正释放 */
 		}
 
 		if (start.node != finish.node) {			//至少有头尾两个缓冲区
 			destroy(start.cur, start.last);			//将头缓冲区内目前所有元素析构
 			destroy(finish.first, finish.cur);		//将尾缓冲区内目前所有元素析构
-			//以下释放缓冲区。注意：头缓冲区保留
-			data_allocator::deallocate(finish.first, buffer_size());
+			//以下归还缓冲区。注意：头缓冲区保留
+			deallocate_buffer(finish.first);
 		}
 		else {		//只有一个缓冲区
 			destroy(start.cur, finish.cur);		//将元素析构。注意这里不释放缓冲区
@@ -493,11 +805,11 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		++next;
 		difference_type elem_before = pos - start;		//清除点之前的元素个数
 		if (elem_before < (finish - next)) {			//清除点之前的元素比较少就移动清除点之前的元素
-			copy_backward(start, pos, next);
+			lfp::copy_backward(start, pos, next);
 			pop_front();		//移动完毕，第一个元素多余，将其清除
 		}
 		else {			//清除点之后的元素比较少，移动清除点之后的元素
-			copy(next, finish, pos);
+			lfp::copy(next, finish, pos);
 			pop_back();			//移动完毕，最后一个元素多余，将其清除
 		}
 		return start + elem_before;
@@ -515,21 +827,21 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 			difference_type len = last - first;				//清除区间长度
 			difference_type elem_before = first - start;	//清除区间前方的元素个数
 			if (elem_before < (finish - last)) {			//如果前方的元素比较少
-				copy_backward(start, first, last);		//向后移动前方的元素，覆盖掉清除区间
+				lfp::copy_backward(start, first, last);		//向后移动前方的元素，覆盖掉清除区间
 				iterator new_start = start + len;		//标记deque的新起点
 				destroy(start, new_start);				//移动完毕，将多余的元素析构
 				/* 以下将多余的缓冲区释放 */
 				for (map_pointer cur = start.node; cur < new_start.node; ++cur)
-					data_allocator::deallocate(*cur, buffer_size());
+					deallocate_buffer(*cur);
 				start = new_start;		//设定 deque 新起点
 			}
 			else {			//清除区间后方的元素比较少
-				copy(last, finish, first);		//将后方的元素向前移动，覆盖掉清除区间
+				lfp::copy(last, finish, first);		//将后方的元素向前移动，覆盖掉清除区间
 				iterator new_finish = finish - len;		//标记 deque 的新尾点
 				destroy(new_finish, finish);			//移动完毕，将多余的元素析构
 				/* 以下将多余的缓冲区释放 */
 				for (map_pointer cur = new_finish.node + 1; cur <= finish.node; ++cur)
-					data_allocator::deallocate(*cur, buffer_size());
+					deallocate_buffer(*cur);
 				finish = new_finish;		//设定 deque 的新尾点
 			}
 			return start + elem_before;
@@ -562,19 +874,21 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 		value_type x_copy = x;
 		difference_type elem_before = pos - start;		//插入点之前的元素个数
 		
+		//注意：push_front/push_back 可能更换 map，之前的迭代器随之失效，因此之后一律由 start/finish 重新计算
 		if (elem_before < (finish - pos)) {			//如果插入点之前的元素个数比较少
-			iterator front_old = start;				//记录最初的起始位置
 			push_front(front());					//在最前端加入一个与第一元素相同的元素
+			iterator front_old = start + 1;			//原起始位置
 			iterator move_front = front_old + 1;	//原起始位置的元素已压入最前端，因此从原起始位置的下一位置开始移动
-			copy(move_front, pos, front_old);		//将 [move_front, pos) 内的元素前移一格
+			pos = start + (elem_before + 1);
+			lfp::copy(move_front, pos, front_old);		//将 [move_front, pos) 内的元素前移一格
 			--pos;		//pos 前移指向插入位置
 		}
 		else {			//插入点之后的元素个数比较少，在尾端进行操作，过程同上
-			iterator back_old = finish;
 			push_back(back());
+			iterator back_old = finish - 1;			//原结束位置
 			iterator move_back = back_old - 1;		//从原结束位置的前一位置开始复制
-			copy_backward(pos, move_back, back_old);		//移动元素
-			//注意：此时 pos 已经指向正确的插入位置
+			pos = start + elem_before;
+			lfp::copy_backward(pos, move_back, back_old);		//移动元素
 		}
 		*pos = x_copy;		//修改插入位置的元素值
 		return pos;
@@ -582,4 +896,4 @@ inline size_t __deque_buf_size(size_t buf_size, size_t val_size) {
 
 }// end of namespace lfp
 
-#endif // !_STL_DEQUE_H_
\ No newline at end of file
+#endif // !_STL_DEQUE_H_
@@ -1,18 +1,26 @@
 /*
  *stack的实现
  *
- *stack实际不是容器而是一个配接器，其内部使用list作为底层容器（也可使用deque、vector等），因而实现非常简单
+ *stack实际不是容器而是一个配接器，其内部缺省使用vector作为底层容器（也可使用deque、list等），因而实现非常简单
+ *
+ *以vector为底层容器时各操作的复杂度：
+ *	top、size、empty、pop			O(1)
+ *	push、emplace					均摊 O(1)，空间不足时整体搬移，可先以 reserve 预留空间避免
+ *	push_range(first, last)			均摊 O(n)，n 为区间长度
+ *	pop_n(n)						O(n)，只析构元素，不释放空间
  */
 
 #ifndef _STL_STACK_H_
 #define _STL_STACK_H_
 
-#include "5stl_list.h"		//以list作为其底层容器
+#include "4stl_vector.h"	//以vector作为其底层容器
+#include <utility>			//for forward
 
 namespace lfp {
 
-	//省缺以list作为底层容器，用户也可以自己指定
-	template<class T, class Container = list<T>>
+	//省缺以vector作为底层容器，用户也可以自己指定
+	//元素连续存放，push/pop 不必像 list 那样每次配置、释放一个节点
+	template<class T, class Container = vector<T>>
 	class stack {
 	public:
 		typedef typename Container::value_type			value_type;
@@ -25,12 +33,32 @@ namespace lfp {
 		/* 以下利用底层容器的操作实现stack的外接口 */
 	public:
 		stack() : cont() { }
+		explicit stack(const Container& c) : cont(c) { }
 		bool empty() const { return cont.empty(); }
 		size_type size() const { return cont.size(); }
 		reference top() { return cont.back(); }
 		const_reference top() const { return cont.back(); }
 		void push(const value_type& x) { cont.push_back(x); }
 		void pop() { cont.pop_back(); }
+
+		//以参数构造一个临时元素，再经 push_back 复制压入（底层容器没有 emplace_back）
+		template<class... Args>
+		void emplace(Args&&... args) { cont.push_back(value_type(std::forward<Args>(args)...)); }
+
+		//依次压入 [first, last) 内的元素，最后一个元素位于栈顶
+		template<class InputIterator>
+		void push_range(InputIterator first, InputIterator last) {
+			for (; first != last; ++first)
+				cont.push_back(*first);
+		}
+		//弹出栈顶的 n 个元素，n 不得大于 size()
+		void pop_n(size_type n) {
+			for (; n != 0; --n)
+				cont.pop_back();
+		}
+
+		//为底层容器预留空间，要求底层容器提供 reserve
+		void reserve(size_type n) { cont.reserve(n); }
 	};
 
 //	template<class T, class Container>
@@ -45,4 +73,4 @@ namespace lfp {
 
 }// end of namespace lfp
 
-#endif	//! _STL_STACK_H_
\ No newline at end of file
+#endif	//! _STL_STACK_H_
\ No newline at end of file
@@ -1,18 +1,28 @@
 /*
  *queue的实现
  *
- *queue实际不是容器而是一个配接器，其内部使用list作为底层容器（也可使用deque、vector等），因而实现非常简单
+ *queue实际不是容器而是一个配接器，其内部缺省使用deque作为底层容器（也可使用list、circular_buffer等），因而实现非常简单
+ *
+ *以deque为底层容器时各操作的复杂度：
+ *	front、back、size、empty		O(1)
+ *	push、emplace、pop				O(1)，缓冲区在尾端用满、在头端腾空时才配置或归还，
+ *									且 deque 会缓存腾空的缓冲区，稳定的先进先出负载下不再调用配置器
+ *	push_range(first, last)			O(n)，n 为区间长度
+ *	pop_n(n)						O(n)
+ *	reserve(n)						预先扩充 deque 的 map，其后 n 个元素以内的 push 不再更换 map
  */
 
 #ifndef _STL_QUEUE_H_
 #define _STL_QUEUE_H_
 
-#include "5stl_list.h"		//以list作为其底层容器
+#include "6stl_deque.h"		//以deque作为其底层容器
+#include <utility>			//for forward
 
 namespace lfp {
 
-	//省缺以list作为底层容器，用户也可以自己指定
-	template<class T, class Container = list<T>>
+	//省缺以deque作为底层容器，用户也可以自己指定
+	//元素分段连续存放，push/pop 不必像 list 那样每次配置、释放一个节点
+	template<class T, class Container = deque<T>>
 	class queue {
 	public:
 		typedef typename Container::value_type		value_type;
@@ -25,6 +35,7 @@ namespace lfp {
 		/* 以下利用底层容器的操作实现queue的对外接口 */
 	public:
 		queue() : cont() {}
+		explicit queue(const Container& c) : cont(c) {}		//以一个已有的容器初始化，例如指定了容量的 circular_buffer
 		bool empty() const { return cont.empty(); }
 		size_type size() const { return cont.size(); }
 		reference front() { return cont.front(); }
@@ -33,8 +44,27 @@ namespace lfp {
 		const_reference back() const { return cont.back(); }
 		void push(const value_type& x) { cont.push_back(x); }
 		void pop() { cont.pop_front(); }
+
+		//以参数构造一个临时元素，再经 push_back 复制加入队尾（底层容器没有 emplace_back）
+		template<class... Args>
+		void emplace(Args&&... args) { cont.push_back(value_type(std::forward<Args>(args)...)); }
+
+		//依次将 [first, last) 内的元素加入队尾
+		template<class InputIterator>
+		void push_range(InputIterator first, InputIterator last) {
+			for (; first != last; ++first)
+				cont.push_back(*first);
+		}
+		//移除队头的 n 个元素，n 不得大于 size()
+		void pop_n(size_type n) {
+			for (; n != 0; --n)
+				cont.pop_front();
+		}
+
+		//为底层容器预留空间，要求底层容器提供 reserve
+		void reserve(size_type n) { cont.reserve(n); }
 	};
 
 }// end of namespace lfp
 
-#endif	//! _STL_QUEUE_H_
\ No newline at end of file
+#endif	//! _STL_QUEUE_H_
\ No newline at end of file
@@ -32,5 +32,33 @@ int main()
 	}
 	std::cout << std::endl << std::endl;
 
+	islist.sort();
+	std::cout << "排序后: slist.size() = " << islist.size() << std::endl;
+	for (first = islist.begin(); first != last; ++first) {
+		std::cout << *first << " ";
+	}
+	std::cout << std::endl << std::endl;
+
+	slist<int> islist2;
+	islist2.push_front(100);
+	islist2.push_front(5);
+	islist2.push_front(0);
+	islist.merge(islist2);
+	std::cout << "合并 0 5 100 后: slist.size() = " << islist.size() << ", slist2.size() = " << islist2.size() << std::endl;
+	for (first = islist.begin(); first != last; ++first) {
+		std::cout << *first << " ";
+	}
+	std::cout << std::endl << std::endl;
+
+	islist.reverse();
+	islist.erase_after(islist.begin());		//移除第二个元素
+	islist2.splice_after(islist2.before_begin(), islist, islist.before_begin());	//把第一个元素接合到 islist2
+	std::cout << "逆向、移除第二个元素并接合走第一个元素后: slist.size() = " << islist.size()
+		<< ", slist2.size() = " << islist2.size() << std::endl;
+	for (first = islist.begin(); first != last; ++first) {
+		std::cout << *first << " ";
+	}
+	std::cout << "| " << islist2.front() << std::endl << std::endl;
+
 	return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
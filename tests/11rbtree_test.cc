@@ -1,3 +1,4 @@
+#define __STL_RB_TREE_COMPACT_NODE		//颜色存放在父节点指针的最低位
 #include <mySTL/2stl_algobase.h>	//identity less
 #include <mySTL/3stl_string.h>
 #include <mySTL/11stl_rbtree.h>
@@ -49,13 +50,13 @@ int main()
 
 	auto it1 = iitree.begin();
 	for (; it1 != iitree.end(); ++it1)
-		std::cout << *it1 << "(" << (it1.node->color == __rb_tree_red ? "r" : "b") << ") ";
+		std::cout << *it1 << "(" << (it1.node->color() == __rb_tree_red ? "r" : "b") << ") ";
 	std::cout << std::endl << std::endl;
 
 	it1 = iitree.find(10);
 	auto it2 = iitree.find(100);	  //not find
 	if (it1 != iitree.end()) {
-		std::cout << "find " << *it1 << "  color:" << (it1.node->color == __rb_tree_red ? "red" : "black") << std::endl;
+		std::cout << "find " << *it1 << "  color:" << (it1.node->color() == __rb_tree_red ? "red" : "black") << std::endl;
 	}
 	if (it2 == iitree.end()) {
 		std::cout << "not find 100" << std::endl << std::endl;
@@ -71,17 +72,28 @@ int main()
 
 	it1 = iitree.begin();
 	for (; it1 != iitree.end(); ++it1)
-		std::cout << *it1 << "(" << (it1.node->color == __rb_tree_red ? "r" : "b") << ") ";
+		std::cout << *it1 << "(" << (it1.node->color() == __rb_tree_red ? "r" : "b") << ") ";
 	std::cout << std::endl << std::endl;
 
 
 
+	auto lb = iitree.lower_bound(11);
+	auto ub = iitree.upper_bound(11);
+	auto range = iitree.equal_range(11);
+	std::cout << "lower_bound(11): " << *lb << "  upper_bound(11): " << *ub
+		<< "  equal_range(11) 含 " << distance(range.first, range.second) << " 个元素" << std::endl;
+	std::cout << "lower_bound(9): " << *iitree.lower_bound(9) << "  upper_bound(15) == end(): "
+		<< (iitree.upper_bound(15) == iitree.end() ? "true" : "false") << std::endl;
+	std::cout << "erase(11) 删除 " << iitree.erase(11) << " 个元素，iitree.size() = " << iitree.size() << std::endl << std::endl;
+
+
+
 	iitree.erase(iitree.begin(), iitree.end());
 
 	it1 = iitree.begin();
 	std::cout << "iitree.size() = " << iitree.size() << std::endl;
 	for (; it1 != iitree.end(); ++it1)
-		std::cout << *it1 << "(" << (it1.node->color == __rb_tree_red ? "r" : "b") << ") ";
+		std::cout << *it1 << "(" << (it1.node->color() == __rb_tree_red ? "r" : "b") << ") ";
 	std::cout << std::endl << std::endl;
 
 
@@ -100,7 +112,7 @@ int main()
 	std::cout << "istr.size() = " << istr.size() << std::endl;
 
 	for (auto it = istr.begin(); it != istr.end(); ++it) {
-		printf("(%d,%s:%s) ", it->first, it->second.c_str(), (it.node->color == __rb_tree_red ? "r" : "b"));
+		printf("(%d,%s:%s) ", it->first, it->second.c_str(), (it.node->color() == __rb_tree_red ? "r" : "b"));
 	}
 	printf("\n\n");
 
@@ -114,10 +126,10 @@ int main()
 
 	std::cout << "istr.size() = " << istr.size() << std::endl;
 	for (auto it = istr.begin(); it != istr.end(); ++it) {
-		printf("(%d,%s:%s) ", it->first, it->second.c_str(), (it.node->color == __rb_tree_red ? "r" : "b"));
+		printf("(%d,%s:%s) ", it->first, it->second.c_str(), (it.node->color() == __rb_tree_red ? "r" : "b"));
 	}
 	printf("\n\n");
 
 
 	return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
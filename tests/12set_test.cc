@@ -41,6 +41,17 @@ int main() {
 		std::cout << i << " ";
 	std::cout << std::endl << std::endl;
 
+
+
+	//已排序的区间：直接建立平衡的树，不必逐个插入
+	int sorted[] = { 1, 3, 5, 7, 9, 11, 13 };
+	set<int> sset(sorted, sorted + 7);						//自动检测到已排序
+	set<int> tset(sorted_unique, sorted, sorted + 7);		//由调用者保证已排序
+	std::cout << "size() = " << sset.size() << " " << tset.size() << std::endl;
+	for (int i : tset)
+		std::cout << i << " ";
+	std::cout << std::endl << std::endl;
+
 	return 0;
 
 }
@@ -1,3 +1,4 @@
+#define __STL_RB_TREE_ORDER_STATISTICS		//维护子树大小，提供 nth、rank、distance
 #include <mySTL/13stl_multiset.h>
 #include <iostream>
 
@@ -29,7 +30,18 @@ int main() {
 	std::cout << std::endl << std::endl;
 
 
+
+	int scores[12] = { 72, 95, 61, 88, 72, 99, 54, 80, 88, 67, 91, 72 };
+	multiset<int> board(scores, scores + 12);
+	std::cout << "nth(0) = " << *board.nth(0) << "  nth(6) = " << *board.nth(6)
+		<< "  nth(11) = " << *board.nth(11) << std::endl;
+	std::cout << "中位数 nth(size()/2) = " << *board.nth(board.size() / 2) << std::endl;
+	std::cout << "rank(72) = " << board.rank(72) << "  rank(100) = " << board.rank(100) << std::endl;
+	std::cout << "distance(lower_bound(70), upper_bound(90)) = "
+		<< board.distance(board.lower_bound(70), board.upper_bound(90)) << std::endl << std::endl;
+
+
 	return 0;
-
+
 }
-
+
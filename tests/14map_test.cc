@@ -44,5 +44,16 @@ int main() {
 	std::cout << std::endl;
 
 
+
+	//按键值递增的顺序追加时以 end() 为提示，不必每次从根节点往下寻找
+	map<int, string> log;
+	log.emplace_hint(log.end(), 100, "start");
+	log.insert(log.end(), std::pair<const int, string>(200, "running"));
+	log.emplace_hint(log.end(), 300, "stop");
+	for (std::pair<int, string> p : log)
+		std::cout << p.first << "  " << p.second.c_str() << std::endl;
+	std::cout << std::endl;
+
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <mySTL/21stl_charconv.h>
+#include <mySTL/3stl_string.h>
+#include <string.h>
+#include <stdio.h>
+
+using namespace lfp;
+
+//打印解析结果：数值、消耗的字符数和错误码
+static void show_int(const char* s) {
+	long long value = -1;
+	from_chars_result res = from_chars(s, s + strlen(s), value);
+	printf("\"%s\" -> %lld  used:%d  ec:%d\n", s, value, (int)(res.ptr - s), (int)res.ec);
+}
+
+static void show_double(const char* s) {
+	double value = -1;
+	from_chars_result res = from_chars(s, s + strlen(s), value);
+	printf("\"%s\" -> %.17g  used:%d  ec:%d\n", s, value, (int)(res.ptr - s), (int)res.ec);
+}
+
+int main() {
+	//整数
+	show_int("12345678901234");		//SWAR 一次转换 8 位
+	show_int("-9223372036854775808");
+	show_int("9223372036854775808");	//溢出
+	show_int("42abc");				//只解析前缀
+	show_int("abc");				//非法输入
+	printf("\n");
+
+	//其他进制
+	{
+		unsigned value = 0;
+		const char* s = "ff";
+		from_chars(s, s + 2, value, 16);
+		printf("\"ff\"(16) -> %u\n", value);
+		s = "-1";
+		from_chars_result res = from_chars(s, s + 2, value);
+		printf("\"-1\" -> unsigned  ec:%d\n\n", (int)res.ec);		//无符号不接受负号
+	}
+
+	//浮点数
+	show_double("3.1415926");
+	show_double("-0.000123e-4");
+	show_double("1e23");
+	show_double("2.2250738585072011e-308");	//慢速路径
+	show_double("4.9e-324");
+	show_double("1e400");						//溢出
+	show_double("1e-400");						//下溢：非0的数值舍入为0
+	{
+		float value = -1;
+		const char* s = "1.7e-243";
+		from_chars_result res = from_chars(s, s + strlen(s), value);
+		printf("\"%s\" -> float %g  ec:%d\n", s, value, (int)res.ec);
+	}
+	show_double("inf");
+	printf("\n");
+
+	//直接在 lfp::string 上解析，不需要以'\0'结尾的拷贝
+	{
+		string field("1024,768");
+		int width = 0, height = 0;
+		from_chars_result res = from_chars(field, width);
+		from_chars(res.ptr + 1, field.data() + field.size(), height);
+		printf("\"%s\" -> %d x %d\n\n", field.c_str(), width, height);
+	}
+
+	return 0;
+}
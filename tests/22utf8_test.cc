@@ -0,0 +1,74 @@
+#include <mySTL/22stl_utf8.h>
+#include <mySTL/3stl_string.h>
+#include <string.h>
+#include <stdio.h>
+
+using namespace lfp;
+
+static const char* error_name(utf_error error) {
+	switch (error) {
+	case utf_ok:		return "ok";
+	case utf_too_short:	return "too_short";
+	case utf_too_long:	return "too_long";
+	case utf_overlong:	return "overlong";
+	case utf_too_large:	return "too_large";
+	case utf_surrogate:	return "surrogate";
+	}
+	return "unknown";
+}
+
+//打印校验结果：错误类型和出错位置
+static void show_validate(const char* name, const char* s, size_t n) {
+	utf_result res = validate_utf8(s, s + n);
+	printf("%-12s -> %-10s count:%d\n", name, error_name(res.error), (int)res.count);
+}
+
+int main() {
+	//校验
+	const char* mixed = "hello, world! \xe4\xbd\xa0\xe5\xa5\xbd\xef\xbc\x8c\xe4\xb8\x96\xe7\x95\x8c \xf0\x9f\x98\x80 end";
+	show_validate("mixed", mixed, strlen(mixed));
+	show_validate("truncated", "abc\xe4\xbd", 5);
+	show_validate("stray", "abc\x80xyz", 7);
+	show_validate("overlong", "\xc0\xaf", 2);
+	show_validate("surrogate", "\xed\xa0\x80", 3);
+	show_validate("too large", "\xf4\x90\x80\x80", 4);
+	printf("\n");
+
+	//计数
+	string str(mixed);
+	printf("bytes:%d  code points:%d  utf16 units:%d\n\n", (int)str.size(), (int)count_utf8(str),
+		(int)utf16_length_from_utf8(str.data(), str.data() + str.size()));
+
+	//UTF-8 -> UTF-16 -> UTF-8
+	{
+		char16_t u16[64];
+		utf_result res = convert_utf8_to_utf16(str, u16);
+		printf("utf8 -> utf16: %s, %d units, last unit U+%04X\n", error_name(res.error), (int)res.count, (unsigned)u16[res.count - 1]);
+
+		char back[128];
+		utf_result res2 = convert_utf16_to_utf8(u16, u16 + res.count, back);
+		printf("utf16 -> utf8: %s, %d bytes, round trip %s\n", error_name(res2.error), (int)res2.count,
+			(res2.count == str.size() && memcmp(back, str.data(), res2.count) == 0) ? "equal" : "differ");
+
+		char16_t lone[] = { u'a', 0xD83D, u'b' };		//不成对的高代理项
+		res2 = convert_utf16_to_utf8(lone, lone + 3, back);
+		printf("lone surrogate: %s at %d\n\n", error_name(res2.error), (int)res2.count);
+	}
+
+	//UTF-8 -> UTF-32 -> UTF-8
+	{
+		char32_t u32[64];
+		utf_result res = convert_utf8_to_utf32(str, u32);
+		printf("utf8 -> utf32: %s, %d code points:", error_name(res.error), (int)res.count);
+		for (size_t i = 14; i < res.count && i < 20; ++i)
+			printf(" U+%04X", (unsigned)u32[i]);
+		printf("\n");
+
+		char back[128];
+		utf_result res2 = convert_utf32_to_utf8(u32, u32 + res.count, back);
+		printf("utf32 -> utf8: %s, %d bytes, expect %d\n", error_name(res2.error), (int)res2.count,
+			(int)utf8_length_from_utf32(u32, u32 + res.count));
+	}
+
+	return 0;
+}
@@ -0,0 +1,55 @@
+#include <mySTL/23stl_hash_fun.h>
+#include <mySTL/16stl_hashtable.h>
+#include <mySTL/3stl_string.h>
+#include <stdio.h>
+
+using namespace lfp;
+
+int main() {
+	//连续整数的低位也均匀分布：统计落入 8 个桶（取低3位）的个数
+	{
+		int identity_buckets[8] = { 0 }, mixed_buckets[8] = { 0 };
+		for (int i = 0; i < 8000; i += 8) {		//步长为8的连续ID
+			++identity_buckets[std::hash<int>()(i) & 7];
+			++mixed_buckets[hash<int>()(i) & 7];
+		}
+		printf("std::hash : ");
+		for (int i = 0; i < 8; ++i)
+			printf("%4d", identity_buckets[i]);
+		printf("\nlfp::hash : ");
+		for (int i = 0; i < 8; ++i)
+			printf("%4d", mixed_buckets[i]);
+		printf("\n\n");
+	}
+
+	//字符串：lfp::string 与字符区间结果相同
+	{
+		string s("hello, hash");
+		const char* cs = "hello, hash";
+		printf("hash<string>(\"%s\") = %zx\n", s.c_str(), hash<string>()(s));
+		printf("hash_range(\"%s\")  = %zx\n", cs, hash_range(cs, cs + strlen(cs)));
+		printf("hash<string>(\"\")          = %zx\n", hash<string>()(string()));
+		printf("hash_bytes(cs, 0)          = %zx\n\n", hash_bytes(cs, 0));		//空缓冲区，0 是长度而不是 last
+	}
+
+	//pair 与 tuple：组合顺序不同结果不同
+	{
+		printf("hash(pair(1, 2))  = %zx\n", hash<std::pair<int, int>>()(std::make_pair(1, 2)));
+		printf("hash(pair(2, 1))  = %zx\n", hash<std::pair<int, int>>()(std::make_pair(2, 1)));
+		printf("hash(tuple(1, 2, \"ab\")) = %zx\n\n",
+			hash<std::tuple<int, int, string>>()(std::make_tuple(1, 2, string("ab"))));
+	}
+
+	//作为 hashtable 的 HashFunc 使用
+	{
+		detail::hashtable<string, string, hash<string>, identity<string>, equal_to<string>, alloc>
+			words(50, hash<string>(), equal_to<string>());
+		const char* text[] = { "apple", "banana", "cherry", "apple", "date", "banana" };
+		for (int i = 0; i < 6; ++i)
+			words.insert_unique(string(text[i]));
+		printf("words.size() = %d, bucket_count = %d\n", (int)words.size(), (int)words.bucket_count());
+		printf("count(\"cherry\") = %d, count(\"fig\") = %d\n\n", (int)words.count(string("cherry")), (int)words.count(string("fig")));
+	}
+
+	return 0;
+}
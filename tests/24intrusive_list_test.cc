@@ -0,0 +1,74 @@
+#include <mySTL/24stl_intrusive_list.h>
+#include <iostream>
+
+using namespace lfp;
+
+//连接对象：继承 intrusive_list_node 以便放入活跃链表，另有一个成员节点用于放入超时链表
+struct Connection : public intrusive_list_node {
+	int fd;
+	intrusive_list_node timer_node;
+
+	explicit Connection(int _fd) : fd(_fd) { }
+};
+
+typedef intrusive_list<Connection> active_list;
+typedef intrusive_list<Connection, intrusive_member_hook<Connection, intrusive_list_node, &Connection::timer_node> > timer_list;
+
+template<class List>
+static void print(const char* title, const List& l) {
+	std::cout << title << ": size() = " << l.size() << "  ";
+	for (typename List::const_iterator it = l.begin(); it != l.end(); ++it) {
+		std::cout << it->fd << " ";
+	}
+	std::cout << std::endl;
+}
+
+int main() {
+	Connection conns[6] = { Connection(3), Connection(4), Connection(5), Connection(6), Connection(7), Connection(8) };
+
+	//同一个对象同时位于两个链表之中，插入时不配置任何内存
+	active_list active;
+	timer_list timers;
+	for (int i = 0; i < 6; ++i) {
+		active.push_back(conns[i]);
+		timers.push_front(conns[i]);
+	}
+	print("active", active);
+	print("timers", timers);
+	std::cout << std::endl;
+
+	//O(1) 由对象找到其位置并移除
+	active.remove(conns[2]);
+	timers.erase(timer_list::iterator_to(conns[2]));
+	std::cout << "conns[2].is_linked() = " << conns[2].is_linked() << std::endl;
+	print("active", active);
+	print("timers", timers);
+	std::cout << std::endl;
+
+	//将 fd 为 7 的连接移到最前面
+	active.splice(active.begin(), active, active_list::iterator_to(conns[4]));
+	print("splice 7 to front", active);
+
+	//把前两个元素接合到另一个链表
+	active_list idle;
+	active_list::iterator last = active.begin();
+	++last;
+	++last;
+	idle.splice(idle.end(), active, active.begin(), last);
+	print("active", active);
+	print("idle", idle);
+
+	active.reverse();
+	print("reverse active", active);
+
+	active.swap(idle);
+	print("swap: active", active);
+	print("swap: idle", idle);
+
+	idle.clear();
+	active.clear();
+	timers.clear();
+	std::cout << "after clear conns[0].is_linked() = " << conns[0].is_linked() << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include <mySTL/25stl_intrusive_slist.h>
+#include <iostream>
+
+using namespace lfp;
+
+//定时器对象：继承 intrusive_slist_node 以便放入待触发链表
+struct Timer : public intrusive_slist_node {
+	int id;
+	explicit Timer(int _id) : id(_id) { }
+};
+
+static void print(const char* title, const intrusive_slist<Timer>& l) {
+	std::cout << title << ": size() = " << l.size() << "  ";
+	for (intrusive_slist<Timer>::const_iterator it = l.begin(); it != l.end(); ++it) {
+		std::cout << it->id << " ";
+	}
+	std::cout << std::endl;
+}
+
+int main() {
+	Timer timers[5] = { Timer(1), Timer(2), Timer(3), Timer(4), Timer(5) };
+
+	intrusive_slist<Timer> pending;
+	for (int i = 0; i < 5; ++i)
+		pending.push_front(timers[i]);
+	print("pending", pending);
+
+	//在 3 之后插入，移除 3 之后的元素
+	intrusive_slist<Timer>::iterator it = intrusive_slist<Timer>::iterator_to(timers[2]);
+	pending.erase_after(it);
+	print("erase after 3", pending);
+	pending.insert_after(it, timers[1]);
+	print("insert 2 after 3", pending);
+
+	//把到期的前两个定时器接合到另一个链表
+	intrusive_slist<Timer> expired;
+	it = pending.begin();
+	++it;
+	expired.splice_after(expired.before_begin(), pending, pending.before_begin(), it);
+	print("pending", pending);
+	print("expired", expired);
+
+	pending.reverse();
+	print("reverse pending", pending);
+
+	expired.splice_after(expired.begin(), pending);
+	print("expired", expired);
+	print("pending", pending);
+
+	while (!expired.empty()) {
+		std::cout << "fire " << expired.front().id << std::endl;
+		expired.pop_front();
+	}
+
+	return 0;
+}
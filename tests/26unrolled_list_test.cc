@@ -0,0 +1,63 @@
+#include <mySTL/26stl_unrolled_list.h>
+#include <mySTL/2stl_algobase.h>
+#include <iostream>
+
+using namespace lfp;
+
+template<class List>
+static void print(const char* title, const List& l) {
+	std::cout << title << ": size() = " << l.size() << std::endl;
+	for (typename List::const_iterator it = l.begin(); it != l.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl << std::endl;
+}
+
+int main() {
+	typedef unrolled_list<int> ulist;
+	std::cout << "每个节点容纳 " << (int)ulist::N << " 个 int" << std::endl << std::endl;
+
+	ulist il;
+	for (int i = 0; i < 40; ++i)
+		il.push_back(i);
+	print("push_back 0~39", il);
+
+	//在中间插入，节点满时对半分裂
+	ulist::iterator it = find(il.begin(), il.end(), 20);
+	for (int i = 0; i < 5; ++i)
+		it = il.insert(it, 100 + i);
+	print("在20之前依次插入100~104", il);
+
+	//移除一段，节点不足半满时与后一个节点合并
+	it = find(il.begin(), il.end(), 5);
+	ulist::iterator last = find(il.begin(), il.end(), 30);
+	it = il.erase(it, last);
+	std::cout << "erase 返回的迭代器指向 " << *it << std::endl;
+	print("erase [5, 30)", il);
+
+	//把另一个链表接合到开头
+	ulist il2;
+	for (int i = 0; i < 3; ++i)
+		il2.push_front(-i);
+	il.splice(il.begin(), il2);
+	print("splice -2 -1 0 到开头", il);
+	std::cout << "il2.size() = " << il2.size() << std::endl << std::endl;
+
+	//同一链表内接合：把最后一个元素移到第二个位置
+	it = il.begin();
+	++it;
+	il.splice(it, il, --il.end());
+	print("把最后一个元素移到第二个位置", il);
+
+	while (il.size() > 3)
+		il.pop_front();
+	print("pop_front 到只剩3个", il);
+
+	//反向遍历
+	for (it = il.end(); it != il.begin(); ) {
+		std::cout << *--it << " ";
+	}
+	std::cout << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,66 @@
+#include <mySTL/27stl_circular_buffer.h>
+#include <mySTL/8stl_queue.h>
+#include <iostream>
+
+using namespace lfp;
+
+template<class Buffer>
+static void print(const char* title, const Buffer& cb) {
+	std::cout << title << ": size() = " << cb.size() << ", capacity() = " << cb.capacity() << std::endl;
+	for (typename Buffer::const_iterator it = cb.begin(); it != cb.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl << std::endl;
+}
+
+int main() {
+	circular_buffer<int> cb(6);		//容量向上取整为 8
+	for (int i = 0; i < 8; ++i)
+		cb.push_back(i);
+	print("push_back 0~7", cb);
+
+	//已满，缺省策略覆盖最旧的元素
+	cb.push_back(8);
+	cb.push_back(9);
+	print("覆盖模式下再 push_back 8 9", cb);
+
+	//两段连续区间
+	circular_buffer<int>::array_range one = cb.array_one();
+	circular_buffer<int>::array_range two = cb.array_two();
+	std::cout << "array_one: ";
+	for (size_t i = 0; i < one.second; ++i)
+		std::cout << one.first[i] << " ";
+	std::cout << "| array_two: ";
+	for (size_t i = 0; i < two.second; ++i)
+		std::cout << two.first[i] << " ";
+	std::cout << std::endl << std::endl;
+
+	cb.pop_front(3);
+	std::cout << "pop_front(3) 后: cb[0] = " << cb[0] << ", front() = " << cb.front()
+		<< ", back() = " << cb.back() << ", end() - begin() = " << (cb.end() - cb.begin()) << std::endl << std::endl;
+
+	//拒绝模式
+	circular_buffer<int> rb(4, circular_buffer_reject);
+	int arr[] = { 1, 2, 3, 4, 5, 6 };
+	size_t accepted = rb.push_back(arr, arr + 6);
+	std::cout << "拒绝模式下加入 6 个元素，接受 " << accepted << " 个" << std::endl;
+	print("rb", rb);
+
+	rb.set_capacity(2);
+	print("set_capacity(2) 后保留最新的元素", rb);
+
+	//作为 queue 的底层容器
+	queue<int, circular_buffer<int> > q(circular_buffer<int>(16, circular_buffer_reject));
+	for (int i = 0; i < 5; ++i)
+		q.push(i * 10);
+	q.pop();
+	std::cout << "queue: size() = " << q.size() << ", front() = " << q.front() << ", back() = " << q.back() << std::endl;
+
+	//缺省构造的 circular_buffer 在第一次 push 时配置空间
+	queue<int, circular_buffer<int> > dq;
+	for (int i = 0; i < 3; ++i)
+		dq.push(i);
+	std::cout << "缺省构造的 queue: size() = " << dq.size() << ", front() = " << dq.front() << ", back() = " << dq.back() << std::endl;
+
+	return 0;
+}
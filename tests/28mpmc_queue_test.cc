@@ -0,0 +1,72 @@
+#include <mySTL/28stl_mpmc_queue.h>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+using namespace lfp;
+
+
+int main() {
+	mpmc_queue<int> q(6);		//容量向上取整为 8
+	std::cout << "capacity() = " << q.capacity() << std::endl;
+
+	int pushed = 0;
+	while (q.try_push(pushed))
+		++pushed;
+	std::cout << "队列满之前加入了 " << pushed << " 个元素" << std::endl;
+
+	int x = -1;
+	q.try_pop(x);
+	std::cout << "try_pop 取出 " << x << ", size_approx() = " << q.size_approx() << std::endl;
+
+	int out[8];
+	size_t n = q.try_pop_n(out, 8);
+	std::cout << "try_pop_n 取出 " << n << " 个: ";
+	for (size_t i = 0; i < n; ++i)
+		std::cout << out[i] << " ";
+	std::cout << std::endl;
+
+	int arr[] = { 100, 101, 102 };
+	std::cout << "try_push_n 加入 " << q.try_push_n(arr, 3) << " 个" << std::endl << std::endl;
+	q.try_pop_n(out, 8);
+
+	//4 个生产者、4 个消费者并发收发，检查元素总和
+	const int producers = 4, consumers = 4, per_producer = 100000;
+	mpmc_queue<long> mq(1024);
+	std::atomic<long> sum(0);
+	std::atomic<int> received(0);
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p) {
+		threads.push_back(std::thread([&mq, p]() {
+			for (int i = 0; i < per_producer; ++i) {
+				long v = long(p) * per_producer + i;
+				while (!mq.try_push(v))
+					std::this_thread::yield();
+			}
+		}));
+	}
+	for (int c = 0; c < consumers; ++c) {
+		threads.push_back(std::thread([&]() {
+			long buf[16];
+			while (received.load() < producers * per_producer) {
+				size_t k = mq.try_pop_n(buf, 16);
+				if (k == 0) {
+					std::this_thread::yield();
+					continue;
+				}
+				for (size_t i = 0; i < k; ++i)
+					sum += buf[i];
+				received += int(k);
+			}
+		}));
+	}
+	for (size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+
+	long total = long(producers) * per_producer;
+	std::cout << "并发收发 " << received.load() << " 个元素，总和"
+		<< (sum.load() == total * (total - 1) / 2 ? "正确" : "错误") << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include <mySTL/29stl_spsc_queue.h>
+#include <iostream>
+#include <thread>
+
+using namespace lfp;
+
+
+int main() {
+	spsc_queue<int> q(4);
+	std::cout << "capacity() = " << q.capacity() << std::endl;
+
+	int arr[] = { 1, 2, 3, 4, 5, 6 };
+	std::cout << "push_n 6 个元素，加入 " << q.push_n(arr, 6) << " 个" << std::endl;
+
+	//front() 不复制元素，处理完再 pop()
+	while (int* p = q.front()) {
+		std::cout << *p << " ";
+		q.pop();
+	}
+	std::cout << std::endl << std::endl;
+
+	//一个生产者线程、一个消费者线程，检查元素的顺序
+	const long count = 1000000;
+	spsc_queue<long> sq(1024);
+	std::thread producer([&sq]() {
+		long batch[32];
+		long next = 0;
+		while (next < count) {
+			long n = 0;
+			for (; n < 32 && next + n < count; ++n)
+				batch[n] = next + n;
+			size_t k = sq.push_n(batch, size_t(n));
+			if (k == 0)
+				std::this_thread::yield();
+			next += long(k);
+		}
+	});
+
+	bool in_order = true;
+	long expect = 0;
+	long buf[64];
+	while (expect < count) {
+		size_t k = sq.pop_n(buf, 64);
+		if (k == 0)
+			std::this_thread::yield();
+		for (size_t i = 0; i < k; ++i) {
+			if (buf[i] != expect)
+				in_order = false;
+			++expect;
+		}
+	}
+	producer.join();
+	std::cout << "收到 " << expect << " 个元素，顺序" << (in_order ? "正确" : "错误") << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include <mySTL/30stl_work_stealing_deque.h>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+using namespace lfp;
+
+
+int main() {
+	work_stealing_deque<int> wsd(4);
+	for (int i = 0; i < 10; ++i)
+		wsd.push(i);		//超过初始容量，数组扩充
+	std::cout << "push 0~9 后: size_approx() = " << wsd.size_approx() << std::endl;
+
+	int x;
+	wsd.pop(x);
+	std::cout << "owner 从底端 pop: " << x << std::endl;
+	wsd.steal(x);
+	std::cout << "thief 从顶端 steal: " << x << std::endl << std::endl;
+	while (wsd.pop(x)) { }
+
+	//owner 不断 push/pop，3 个 thief 同时 steal，每个元素恰好被取走一次
+	const long count = 200000;
+	work_stealing_deque<long> dq;
+	std::atomic<long> sum(0);
+	std::atomic<long> taken(0);
+	std::vector<std::thread> thieves;
+	for (int i = 0; i < 3; ++i) {
+		thieves.push_back(std::thread([&]() {
+			long v;
+			while (taken.load() < count) {
+				if (dq.steal(v)) {
+					sum += v;
+					++taken;
+				}
+				else {
+					std::this_thread::yield();
+				}
+			}
+		}));
+	}
+	long v;
+	for (long i = 0; i < count; ++i) {
+		dq.push(i);
+		if (i % 3 == 0 && dq.pop(v)) {
+			sum += v;
+			++taken;
+		}
+	}
+	while (dq.pop(v)) {
+		sum += v;
+		++taken;
+	}
+	for (size_t i = 0; i < thieves.size(); ++i)
+		thieves[i].join();
+
+	std::cout << "共取走 " << taken.load() << " 个元素，总和"
+		<< (sum.load() == count * (count - 1) / 2 ? "正确" : "错误") << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,76 @@
+#include <mySTL/31stl_thread_pool.h>
+#include <mySTL/4stl_vector.h>
+#include <iostream>
+#include <stdexcept>
+
+using namespace lfp;
+
+//递归地在 task_group 中分解任务
+static long fib(thread_pool& pool, int n) {
+	if (n < 15) {
+		long a = 0, b = 1;
+		for (int i = 0; i < n; ++i) {
+			long t = a + b;
+			a = b;
+			b = t;
+		}
+		return a;
+	}
+	long x = 0;
+	task_group group(pool);
+	group.run([&pool, &x, n]() { x = fib(pool, n - 1); });
+	long y = fib(pool, n - 2);
+	group.wait();
+	return x + y;
+}
+
+int main() {
+	thread_pool pool(4);
+	std::cout << "pool.size() = " << pool.size() << std::endl;
+
+	//parallel_for 求和
+	vector<int> vec(1000000, 1);
+	std::atomic<long> sum(0);
+	parallel_for(pool, size_t(0), vec.size(), 4096, [&](size_t first, size_t last) {
+		long s = 0;
+		for (size_t i = first; i < last; ++i)
+			s += vec[i];
+		sum += s;
+	});
+	std::cout << "parallel_for 求和: " << sum.load() << std::endl;
+
+	//parallel_for 也可以直接作用于迭代器区间
+	parallel_for(pool, vec.begin(), vec.end(), 4096, [](int* first, int* last) {
+		for (; first != last; ++first)
+			*first *= 2;
+	});
+	std::cout << "parallel_for 修改后: vec[0] = " << vec[0] << ", vec.back() = " << vec.back() << std::endl;
+
+	std::cout << "fib(30) = " << fib(pool, 30) << std::endl;
+
+	//任务抛出的异常由 wait() 重新抛出
+	task_group group(pool);
+	for (int i = 0; i < 8; ++i) {
+		group.run([i]() {
+			if (i == 5)
+				throw std::runtime_error("task 5 failed");
+		});
+	}
+	try {
+		group.wait();
+	}
+	catch (const std::exception& e) {
+		std::cout << "wait() 抛出异常: " << e.what() << std::endl;
+	}
+
+	//不属于 task_group 的任务，在线程池析构前都会执行完
+	std::atomic<int> done(0);
+	{
+		thread_pool small(2);
+		for (int i = 0; i < 100; ++i)
+			small.submit([&done]() { ++done; });
+	}
+	std::cout << "submit 的 100 个任务完成 " << done.load() << " 个" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,48 @@
+#include <mySTL/33stl_btree_set.h>
+#include <mySTL/34stl_btree_multiset.h>
+#include <iostream>
+
+using namespace lfp;
+
+int main() {
+	int ia[5] = { 0, 1, 2, 3, 4 };
+	btree_set<int> iset(ia, ia + 5);
+
+	std::cout << "size() = " << iset.size() << "  count(3) = " << iset.count(3) << std::endl;
+	iset.insert(3);
+	std::cout << "size() = " << iset.size() << "  count(3) = " << iset.count(3) << std::endl << std::endl;
+
+
+
+	//一个节点可以放几十个 int，插入足够多的元素才会分裂出多层
+	for (int i = 1000; i > 5; --i)
+		iset.insert(i);
+	std::cout << "size() = " << iset.size() << "  *find(500) = " << *iset.find(500) << std::endl;
+	btree_set<int>::iterator it = iset.lower_bound(995);
+	//*it = 0;		//非法
+	for (; it != iset.end(); ++it)
+		std::cout << *it << " ";
+	std::cout << std::endl << std::endl;
+
+
+
+	iset.erase(iset.find(10), iset.find(990));	 // [)
+	std::cout << "size() = " << iset.size() << std::endl;
+	for (int i : iset)
+		std::cout << i << " ";
+	std::cout << std::endl << std::endl;
+
+
+
+	btree_multiset<int> mset(ia, ia + 5);
+	mset.insert(3);
+	mset.insert(mset.end(), 3);
+	std::cout << "size() = " << mset.size() << "  count(3) = " << mset.count(3) << std::endl;
+	std::pair<btree_multiset<int>::iterator, btree_multiset<int>::iterator> range = mset.equal_range(3);
+	for (it = range.first; it != range.second; ++it)
+		std::cout << *it << " ";
+	std::cout << std::endl;
+	std::cout << "erase(3) = " << mset.erase(3) << "  size() = " << mset.size() << std::endl << std::endl;
+
+	return 0;
+}
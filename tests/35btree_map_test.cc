@@ -0,0 +1,55 @@
+#include <mySTL/3stl_string.h>
+#include <mySTL/35stl_btree_map.h>
+#include <mySTL/36stl_btree_multimap.h>
+#include <iostream>
+
+using namespace lfp;
+
+int main() {
+	btree_map<string, int> simap;
+
+	simap[string("stringY")] = 'Y';
+	simap[string("stringD")] = 'D';
+	simap[string("stringM")] = 'M';
+	simap[string("stringA")] = 'A';
+
+	std::pair<string, int> value("stringM", 100);	//insert failed
+	simap.insert(value);
+
+	value = std::pair<string, int>(string("stringF"), 'F');
+	simap.insert(value);
+
+	btree_map<string, int>::iterator it = simap.begin();
+	std::cout << "simap.size() = " << simap.size() << std::endl;
+	for (; it != simap.end(); ++it)
+		std::cout << it->first.c_str() << "  " << it->second << std::endl;
+	std::cout << std::endl;
+
+
+
+	simap[string("stringM")] = 666;
+	it = simap.find("stringY");
+	if (it != simap.end())
+		it->second = 777;
+	simap.erase(simap.begin(), simap.find("stringF"));
+	btree_map<string, int>::const_iterator cit = simap.find("stringZ");
+	std::cout << "find(\"stringZ\") == end(): " << (simap.end() == cit) << std::endl;	//iterator 与 const_iterator 可以比较
+	for (std::pair<string, int> p : simap)
+		std::cout << p.first.c_str() << "  " << p.second << std::endl;
+	std::cout << std::endl;
+
+
+
+	//按键值递增的顺序追加时以 end() 为提示，节点几乎都是满的
+	btree_multimap<int, string> log;
+	log.emplace_hint(log.end(), 100, "start");
+	log.insert(log.end(), std::pair<const int, string>(200, "running"));
+	log.emplace(200, "paused");
+	log.emplace_hint(log.end(), 300, "stop");
+	std::cout << "count(200) = " << log.count(200) << std::endl;
+	for (std::pair<int, string> p : log)
+		std::cout << p.first << "  " << p.second.c_str() << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
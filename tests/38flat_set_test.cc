@@ -0,0 +1,48 @@
+#include <mySTL/38stl_flat_set.h>
+#include <mySTL/39stl_flat_multiset.h>
+#include <iostream>
+
+using namespace lfp;
+
+int main() {
+	int ia[8] = { 5, 3, 9, 1, 3, 7, 0, 9 };
+	flat_set<int> iset(ia, ia + 8);		//全部追加后排序，只合并一次
+
+	std::cout << "size() = " << iset.size() << "  count(3) = " << iset.count(3) << std::endl;
+	const int* p = iset.data();			//底层为连续存储
+	for (size_t i = 0; i < iset.size(); ++i)
+		std::cout << p[i] << " ";
+	std::cout << std::endl << std::endl;
+
+
+
+	int ib[5] = { 8, 2, 6, 4, 3 };
+	iset.insert(ib, ib + 5);
+	iset.insert(10);
+	flat_set<int>::iterator it = iset.begin();
+	//*it = 0;		//非法
+	std::cout << "size() = " << iset.size() << std::endl;
+	for (; it != iset.end(); ++it)
+		std::cout << *it << " ";
+	std::cout << std::endl << std::endl;
+
+
+
+	iset.erase(iset.begin(), iset.find(5));	 // [)
+	std::cout << "size() = " << iset.size() << "  *lower_bound(6) = " << *iset.lower_bound(6) << std::endl;
+	for (int i : iset)
+		std::cout << i << " ";
+	std::cout << std::endl << std::endl;
+
+
+
+	flat_multiset<int> mset(ia, ia + 8);
+	mset.insert(ib, ib + 5);
+	std::cout << "size() = " << mset.size() << "  count(3) = " << mset.count(3) << std::endl;
+	for (int i : mset.sequence())
+		std::cout << i << " ";
+	std::cout << std::endl;
+	std::cout << "erase(9) = " << mset.erase(9) << "  size() = " << mset.size() << std::endl << std::endl;
+
+	return 0;
+}
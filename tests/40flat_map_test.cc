@@ -0,0 +1,52 @@
+#include <mySTL/3stl_string.h>
+#include <mySTL/40stl_flat_map.h>
+#include <mySTL/41stl_flat_multimap.h>
+#include <iostream>
+
+using namespace lfp;
+
+int main() {
+	flat_map<string, int> simap;
+
+	simap[string("stringY")] = 'Y';
+	simap[string("stringD")] = 'D';
+	simap[string("stringM")] = 'M';
+	simap[string("stringA")] = 'A';
+
+	std::pair<string, int> value("stringM", 100);	//insert failed
+	simap.insert(value);
+
+	value = std::pair<string, int>(string("stringF"), 'F');
+	simap.insert(value);
+
+	flat_map<string, int>::iterator it = simap.begin();
+	std::cout << "simap.size() = " << simap.size() << std::endl;
+	for (; it != simap.end(); ++it)
+		std::cout << it->first.c_str() << "  " << it->second << std::endl;
+	std::cout << std::endl;
+
+
+
+	//建立一次、之后只做查找：批量插入，键值重复时保留先出现的
+	std::pair<int, string> batch[5] = {
+		std::pair<int, string>(30, "thirty"), std::pair<int, string>(10, "ten"),
+		std::pair<int, string>(20, "twenty"), std::pair<int, string>(10, "TEN"),
+		std::pair<int, string>(40, "forty")
+	};
+	flat_map<int, string> table(batch, batch + 5);
+	std::cout << "table.size() = " << table.size() << "  table[10] = " << table[10].c_str() << std::endl;
+	if (table.find(25) == table.end())
+		std::cout << "25 not found" << std::endl;
+	std::cout << std::endl;
+
+
+
+	flat_multimap<int, string> log(batch, batch + 5);
+	log.emplace(20, "again");
+	std::cout << "count(10) = " << log.count(10) << std::endl;
+	for (std::pair<int, string> p : log)
+		std::cout << p.first << "  " << p.second.c_str() << std::endl;
+	std::cout << std::endl;
+
+	return 0;
+}
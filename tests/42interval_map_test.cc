@@ -0,0 +1,69 @@
+#include <mySTL/3stl_string.h>
+#include <mySTL/42stl_interval_map.h>
+#include <iostream>
+
+using namespace lfp;
+
+//打印区间及其实值
+struct print_interval {
+	template<class Value>
+	void operator()(const Value& v) const {
+		std::cout << "[" << v.first.low << ", " << v.first.high << "]  " << v.second.c_str() << std::endl;
+	}
+};
+
+//统计结果个数
+struct count_interval {
+	int n;
+	count_interval() : n(0) { }
+	template<class Value>
+	void operator()(const Value&) { ++n; }
+};
+
+int main() {
+	//IP 段（以整数表示）到机房的映射
+	interval_map<unsigned, string> ip;
+	ip.insert(0x0A000000u, 0x0A0000FFu, "office");
+	ip.insert(0x0A000100u, 0x0A0001FFu, "lab");
+	ip.insert(0xC0A80000u, 0xC0A8FFFFu, "home");
+	ip.insert(0x0A000000u, 0x0AFFFFFFu, "intranet");
+
+	std::cout << "ip.size() = " << ip.size() << std::endl;
+	std::cout << std::hex;
+	std::cout << "stabbing(0x0A000105):" << std::endl;
+	ip.stabbing(0x0A000105u, print_interval());
+	std::cout << "stabbing(0x08080808):" << std::endl;
+	ip.stabbing(0x08080808u, print_interval());
+	std::cout << std::dec << std::endl;
+
+
+
+	//时间窗：允许重叠和重复
+	interval_map<int, string> tasks;
+	tasks.insert(9, 12, "meeting");
+	tasks.insert(10, 18, "build");
+	tasks.insert(13, 14, "lunch");
+	tasks.emplace(interval<int>(15, 16), "deploy");		//就地构造实值
+	tasks.insert(13, 14, "lunch");
+
+	std::cout << "all tasks:" << std::endl;
+	for (interval_map<int, string>::iterator it = tasks.begin(); it != tasks.end(); ++it)
+		std::cout << "[" << it->first.low << ", " << it->first.high << "]  " << it->second.c_str() << std::endl;
+	std::cout << "overlapping(12, 13):" << std::endl;
+	tasks.overlapping(12, 13, print_interval());
+	std::cout << "count of overlapping(0, 100) = " << tasks.overlapping(0, 100, count_interval()).n << std::endl;
+	std::cout << std::endl;
+
+
+
+	//通过 iterator 修改实值，按区间删除
+	tasks.find(interval<int>(10, 18))->second = "release";
+	std::cout << "erase(13, 14) = " << tasks.erase(13, 14) << std::endl;
+	tasks.erase(tasks.begin());
+	const interval_map<int, string>& ctasks = tasks;
+	std::cout << "stabbing(15):" << std::endl;
+	ctasks.stabbing(15, print_interval());
+	std::cout << std::endl;
+
+	return 0;
+}
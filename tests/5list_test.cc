@@ -63,5 +63,48 @@ int main() {
 	std::cout << std::endl << std::endl;
 
 
+	ilist.sort(greater<int>());
+	std::cout << "按 greater 排序后: ilist.size() = " << ilist.size() << std::endl;
+	for (it = ilist.begin(); it != ilist.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl << std::endl;
+
+
+	list<int> ilist2;
+	ilist2.push_back(10);
+	ilist2.push_back(4);
+	ilist2.push_back(0);
+	ilist.merge(ilist2, greater<int>());
+	std::cout << "合并 10 4 0 后: ilist.size() = " << ilist.size() << ", ilist2.size() = " << ilist2.size() << std::endl;
+	for (it = ilist.begin(); it != ilist.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl << std::endl;
+
+
+	//批量构造与区间插入
+	list<int> ilist3(3, 7);
+	int arr[] = { 1, 2, 3 };
+	ilist3.insert(++ilist3.begin(), arr, arr + 3);
+	ilist3.insert(ilist3.end(), 2, 0);
+	list<int> ilist4(ilist3);
+	std::cout << "list(3, 7) 中插入 1 2 3 与 0 0 后的拷贝: ilist4.size() = " << ilist4.size() << std::endl;
+	for (it = ilist4.begin(); it != ilist4.end(); ++it) {
+		std::cout << *it << " ";
+	}
+	std::cout << std::endl << std::endl;
+
+	//两个整数参数仍是填充构造与填充插入，不会被当作迭代器区间
+	list<double> dlist(3, 0);
+	list<long> llist;
+	llist.insert(llist.begin(), 3L, 9L);
+	std::cout << "list<double>(3, 0).size() = " << dlist.size() << ", front() = " << dlist.front() << std::endl;
+	std::cout << "list<long> insert(begin(), 3L, 9L): ";
+	for (list<long>::iterator lit = llist.begin(); lit != llist.end(); ++lit) {
+		std::cout << *lit << " ";
+	}
+	std::cout << std::endl << std::endl;
+
 	return 0;
 }
@@ -1,4 +1,5 @@
 #include <mySTL/6stl_deque.h>
+#include <mySTL/4stl_vector.h>
 #include <iostream>
 
 using namespace lfp;
@@ -63,5 +64,49 @@ int main() {
 	}
 	cout << endl << endl;
 
+
+	//队列式使用：尾进头出，腾空的缓冲区进入空闲缓存，供尾端再次使用
+	deque<int, alloc, 8> fifo;
+	for (int round = 0; round < 1000; ++round) {
+		for (int i = 0; i < 20; ++i)
+			fifo.push_back(round * 20 + i);
+		for (int i = 0; i < 20; ++i)
+			fifo.pop_front();
+	}
+	fifo.push_back(1);
+	fifo.push_back(2);
+	fifo.shrink_to_fit();		//交还缓存的空闲缓冲区
+	cout << "7: fifo.size() = " << fifo.size() << endl;
+	for (int i : fifo) {
+		cout << i << " ";
+	}
+	cout << endl << endl;
+
+
+	deque<int, alloc, 8> que2(que);
+	que2.pop_front();
+	que = que2;
+	cout << "8: que.size() = " << que.size() << endl;
+	for (int i : que) {
+		cout << i << " ";
+	}
+	cout << endl << endl;
+
+	//缓冲区容纳的元素个数总是 2 的幂：指定 20 个时取 32，缺省时取 512 字节内最多的 2 的幂
+	cout << "9: buffer_size = " << deque<int, alloc, 20>::buffer_size()
+		<< ", " << deque<int>::buffer_size() << ", " << deque<double[5]>::buffer_size() << endl;
+
+		//分段算法：逐个缓冲区处理，int 的拷贝按段走 memmove
+	deque<int, alloc, 8> sorted;
+	for (int i = 0; i < 30; ++i)
+		sorted.push_back(i * 2);
+	vector<int> vec(30, 0);
+	copy(sorted.begin(), sorted.end(), vec.begin());
+	fill(sorted.begin() + 10, sorted.begin() + 20, -1);
+	copy(vec.begin() + 10, vec.begin() + 20, sorted.begin() + 10);
+	cout << "10: vec.back() = " << vec.back()
+		<< ", find(26) at " << (find(sorted.begin(), sorted.end(), 26) - sorted.begin())
+		<< ", lower_bound(27) at " << (lower_bound(sorted.begin(), sorted.end(), 27) - sorted.begin()) << endl;
+
 	return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include <mySTL/7stl_stack.h>
+#include <mySTL/5stl_list.h>
 #include <iostream>
 
 using namespace lfp;
@@ -6,7 +7,7 @@ using namespace std;
 
 
 int main() {
-	stack<int> s;
+	stack<int> s;		//缺省以 vector 作为底层容器
 	s.push(1);
 	s.push(3);
 	s.push(5);
@@ -19,7 +20,21 @@ int main() {
 	cout << "stack.top() = " << s.top() << endl; s.pop();
 	cout << "stack.top() = " << s.top() << endl; s.pop();
 
-	cout << "\nstack.size() = " << s.size() << endl;
+	cout << "\nstack.size() = " << s.size() << endl << endl;
+
+	//批量操作
+	int arr[] = { 10, 20, 30, 40, 50 };
+	s.reserve(16);
+	s.push_range(arr, arr + 5);
+	s.emplace(60);
+	s.pop_n(2);
+	cout << "push_range 10~50、emplace 60、pop_n(2) 后: stack.size() = " << s.size()
+		<< ", stack.top() = " << s.top() << endl;
+
+	//也可以指定 list 作为底层容器
+	stack<int, list<int> > ls;
+	ls.push_range(arr, arr + 5);
+	cout << "stack<int, list<int> >: stack.top() = " << ls.top() << endl;
 
 	return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -6,7 +6,7 @@ using namespace std;
 
 
 int main() {
-	queue<int> que;
+	queue<int> que;		//缺省以 deque 作为底层容器
 	que.push(1);
 	que.push(3);
 	que.push(5);
@@ -21,5 +21,14 @@ int main() {
 
 	cout << "\nqueue.size() = " << que.size() << endl << endl;
 
+	//批量操作
+	int arr[] = { 10, 20, 30, 40, 50 };
+	que.reserve(1000);
+	que.push_range(arr, arr + 5);
+	que.emplace(60);
+	que.pop_n(2);
+	cout << "push_range 10~50、emplace 60、pop_n(2) 后: queue.size() = " << que.size()
+		<< ", queue.front() = " << que.front() << ", queue.back() = " << que.back() << endl;
+
 	return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file